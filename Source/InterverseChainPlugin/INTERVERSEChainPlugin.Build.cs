@@ -32,6 +32,17 @@ public class InterverseChainPlugin : ModuleRules
             }
         );
 
+        // Automation tests stand up a local HTTP server for the request dispatcher
+        if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+        {
+            PrivateDependencyModuleNames.AddRange(
+                new string[]
+                {
+                    "HTTPServer"
+                }
+            );
+        }
+
         if (Target.Type == TargetRules.TargetType.Editor)
         {
             PublicDependencyModuleNames.AddRange(
@@ -1,12 +1,295 @@
 #include "InterverseChainComponent.h"
 #include "InterverseCompatibility.h"
+#include "InterverseMessageRegistry.h"
+#include "InterverseJsonListReader.h"
+#include "InterverseWireFormat.h"
+#include "InterverseStats.h"
 #include "JsonObjectConverter.h"
-#include "WebSocketsModule.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Tasks/Pipe.h"
+#include "HAL/FileManager.h"
+#include "Algo/AllOf.h"
+
+DECLARE_CYCLE_STAT(TEXT("Decode Payload (Worker)"), STAT_InterverseDecodePayload, STATGROUP_Interverse);
+DECLARE_CYCLE_STAT(TEXT("Apply Payload (Game Thread)"), STAT_InterverseApplyPayload, STATGROUP_Interverse);
+
+namespace
+{
+    TSharedPtr<FJsonObject> ParseJsonObject(const FString& Content)
+    {
+        TSharedPtr<FJsonObject> JsonObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+        {
+            return nullptr;
+        }
+        return JsonObject;
+    }
+
+    // Ledger file reads and writes from every component run one at a time, in the order issued
+    UE::Tasks::FPipe LedgerFilePipe{ TEXT("InterverseLedgerFile") };
+
+    // Whether Text is exactly one well-formed JSON object or array
+    bool IsJsonDocument(const FString& Text)
+    {
+        const FString Trimmed = Text.TrimStartAndEnd();
+        if (!Trimmed.StartsWith(TEXT("{")) && !Trimmed.StartsWith(TEXT("[")))
+        {
+            return false;
+        }
+
+        TSharedPtr<FJsonValue> Value;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Trimmed);
+        return FJsonSerializer::Deserialize(Reader, Value) && Value.IsValid();
+    }
+
+    // Appends Value as a quoted JSON string literal
+    void AppendJsonString(FString& Out, const FString& Value)
+    {
+        Out.AppendChar(TEXT('"'));
+        for (const TCHAR Char : Value)
+        {
+            switch (Char)
+            {
+            case TEXT('"'):  Out += TEXT("\\\""); break;
+            case TEXT('\\'): Out += TEXT("\\\\"); break;
+            case TEXT('\n'): Out += TEXT("\\n"); break;
+            case TEXT('\r'): Out += TEXT("\\r"); break;
+            case TEXT('\t'): Out += TEXT("\\t"); break;
+            case TEXT('\b'): Out += TEXT("\\b"); break;
+            case TEXT('\f'): Out += TEXT("\\f"); break;
+            default:
+                if (Char < 0x20)
+                {
+                    Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+                }
+                else
+                {
+                    Out.AppendChar(Char);
+                }
+                break;
+            }
+        }
+        Out.AppendChar(TEXT('"'));
+    }
+
+    bool DecodeBalancePayload(const FString& Content, float& OutBalance)
+    {
+        TSharedPtr<FJsonObject> JsonObject = ParseJsonObject(Content);
+        const TSharedPtr<FJsonObject>* DataObject;
+        if (!JsonObject.IsValid() || !JsonObject->TryGetObjectField(TEXT("data"), DataObject))
+        {
+            return false;
+        }
+
+        double Value = 0.0;
+        if (!(*DataObject)->TryGetNumberField(TEXT("balance"), Value))
+        {
+            return false;
+        }
+        OutBalance = static_cast<float>(Value);
+        return true;
+    }
+
+    // Builds the whole list for the cache and delegates; the chunking only bounds parser scratch space
+    bool DecodeAssetListPayload(const FString& Content, TArray<FInterverseAsset>& OutAssets)
+    {
+        return FInterverseJsonListReader::ReadAssets(Content, 256, [&OutAssets](TArray<FInterverseAsset>&& Chunk)
+        {
+            OutAssets.Append(MoveTemp(Chunk));
+        });
+    }
+
+    bool DecodeTransactionPage(const FString& Content, FInterverseTransactionPage& OutPage)
+    {
+        TSharedPtr<FJsonObject> JsonObject = ParseJsonObject(Content);
+        const TArray<TSharedPtr<FJsonValue>>* TransactionsArray;
+        if (!JsonObject.IsValid() || !JsonObject->TryGetArrayField(TEXT("transactions"), TransactionsArray))
+        {
+            return false;
+        }
+
+        OutPage.Transactions.Reserve(TransactionsArray->Num());
+        for (const TSharedPtr<FJsonValue>& TransactionValue : *TransactionsArray)
+        {
+            FString TransactionString;
+            if (TransactionValue.IsValid() && TransactionValue->TryGetString(TransactionString))
+            {
+                OutPage.Transactions.Add(MoveTemp(TransactionString));
+            }
+        }
+
+        // Nodes without paging send no cursor, and their single page is the whole list
+        JsonObject->TryGetStringField(TEXT("next_cursor"), OutPage.NextCursor);
+        if (!JsonObject->TryGetBoolField(TEXT("has_more"), OutPage.bHasMore))
+        {
+            OutPage.bHasMore = true;
+        }
+        OutPage.bHasMore = OutPage.bHasMore && !OutPage.NextCursor.IsEmpty();
+
+        JsonObject->TryGetNumberField(TEXT("latest_sequence"), OutPage.LatestSequence);
+        return true;
+    }
+
+    FString MakeHistoryPageKey(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence)
+    {
+        return FString::Printf(TEXT("%s|%s|%d|%lld"), *Address, *Cursor, PageSize, SinceSequence);
+    }
+
+    FString MakeHistoryPagePath(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence)
+    {
+        FString Path = FString::Printf(TEXT("transactions/%s?limit=%d"), *Address, PageSize);
+        if (!Cursor.IsEmpty())
+        {
+            Path += FString::Printf(TEXT("&cursor=%s"), *FGenericPlatformHttp::UrlEncode(Cursor));
+        }
+        if (SinceSequence >= 0)
+        {
+            Path += FString::Printf(TEXT("&since=%lld"), SinceSequence);
+        }
+        return Path;
+    }
+
+    // Chunks decoded on a worker are handed to the game thread in order
+    template <typename ItemType>
+    void PostChunkToGameThread(
+        const TWeakObjectPtr<UInterverseChainComponent>& WeakOwner,
+        const TSharedRef<TFunction<void(const TArray<ItemType>&)>>& OnChunk,
+        TArray<ItemType>&& Chunk)
+    {
+        AsyncTask(ENamedThreads::GameThread, [WeakOwner, OnChunk, Chunk = MoveTemp(Chunk)]()
+        {
+            if (WeakOwner.IsValid() && *OnChunk)
+            {
+                (*OnChunk)(Chunk);
+            }
+        });
+    }
+
+    // Reads a list response on a worker with Read, forwarding each chunk as it is produced
+    template <typename ItemType, typename ReadFuncType>
+    void StreamListResponse(
+        const TWeakObjectPtr<UInterverseChainComponent>& WeakOwner,
+        FHttpResponsePtr Response,
+        bool bSuccess,
+        const TSharedRef<TFunction<void(const TArray<ItemType>&)>>& OnChunk,
+        TFunction<void(bool bSuccess)> OnComplete,
+        ReadFuncType Read)
+    {
+        if (!bSuccess || !Response.IsValid())
+        {
+            if (OnComplete)
+            {
+                OnComplete(false);
+            }
+            return;
+        }
+
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakOwner, Response, OnChunk, OnComplete = MoveTemp(OnComplete), Read]()
+        {
+            bool bParsed = false;
+            {
+                SCOPE_CYCLE_COUNTER(STAT_InterverseDecodePayload);
+                bParsed = Read(Response->GetContentAsString(), [&WeakOwner, &OnChunk](TArray<ItemType>&& Chunk)
+                {
+                    PostChunkToGameThread(WeakOwner, OnChunk, MoveTemp(Chunk));
+                });
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakOwner, bParsed, OnComplete]()
+            {
+                if (WeakOwner.IsValid() && OnComplete)
+                {
+                    OnComplete(bParsed);
+                }
+            });
+        });
+    }
+
+    // Per-endpoint decoders, bound when the request is created
+
+    bool DecodeMintResponse(const FJsonObject& Root, FInterverseDecodedPayload& Out)
+    {
+        const TSharedPtr<FJsonObject>* DataObject;
+        if (!Root.TryGetObjectField(TEXT("data"), DataObject))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Response missing data field"));
+            return false;
+        }
+
+        Out.Type = InterverseMessageTypes::AssetMinted;
+        return InterverseCompat::ConvertJsonToAsset(*DataObject, Out.Asset) && !Out.Asset.AssetId.IsEmpty();
+    }
+
+    bool DecodeTransferResponse(const FJsonObject& Root, FInterverseDecodedPayload& Out)
+    {
+        const TSharedPtr<FJsonObject>* DataObject;
+        if (!Root.TryGetObjectField(TEXT("data"), DataObject))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Response missing data field"));
+            return false;
+        }
+
+        Out.Type = InterverseMessageTypes::TransferComplete;
+        Out.AssetId = (*DataObject)->GetStringField(TEXT("asset_id"));
+        Out.bSuccess = Root.GetBoolField(TEXT("success"));
+        return true;
+    }
+}
 
 UInterverseChainComponent::UInterverseChainComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
-    Http = &FHttpModule::Get();
+    LedgerMirror = MakeShared<FInterverseLedgerMirror>();
+    RegisterBuiltInMessageHandlers();
+}
+
+void UInterverseChainComponent::RegisterBuiltInMessageHandlers()
+{
+    // Handlers live on this component, so capturing this is safe
+    auto OnAsset = [this](const FInterverseDecodedPayload& Payload)
+    {
+        UpdateCachedAsset(Payload.Asset);
+        OnAssetMinted.Broadcast(Payload.Asset, TEXT(""));
+    };
+    MessageHandlers.Add(InterverseMessageTypes::AssetUpdate, OnAsset);
+    MessageHandlers.Add(InterverseMessageTypes::AssetMinted, OnAsset);
+
+    MessageHandlers.Add(InterverseMessageTypes::BalanceUpdate, [this](const FInterverseDecodedPayload& Payload)
+    {
+        // Pushes naming their wallet refresh that entry; anything else could be stale
+        BalancePushGeneration++;
+        if (!Payload.Address.IsEmpty())
+        {
+            UpdateCachedBalance(Payload.Address, Payload.Balance);
+        }
+        else
+        {
+            BalanceCache.Empty();
+        }
+        OnBalanceUpdated.Broadcast(Payload.Balance);
+    });
+
+    MessageHandlers.Add(InterverseMessageTypes::TransferComplete, [this](const FInterverseDecodedPayload& Payload)
+    {
+        InvalidateCachedAsset(Payload.AssetId);
+        OnTransferComplete.Broadcast(Payload.AssetId, TEXT(""), Payload.bSuccess);
+    });
+}
+
+void UInterverseChainComponent::RegisterMessageHandler(FName Type, FInterverseMessageHandler Handler)
+{
+    MessageHandlers.Add(Type, MoveTemp(Handler));
+}
+
+void UInterverseChainComponent::UnregisterMessageHandler(FName Type)
+{
+    MessageHandlers.Remove(Type);
 }
 
 void UInterverseChainComponent::BeginPlay()
@@ -22,44 +305,127 @@ void UInterverseChainComponent::BeginPlay()
         return;
     }
 
+    if (bPersistLedgerMirror)
+    {
+        LoadLedgerMirror();
+    }
+
     ConnectWebSocket();
 }
 
 void UInterverseChainComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     UE_LOG(LogTemp, Log, TEXT("InterverseChainComponent EndPlay"));
+    FlushTransactionBatch();
     DisconnectWebSocket();
+
+    // The dispatcher outlives us if other components share the node; settle what we queued on it
+    if (HttpDispatcher.IsValid())
+    {
+        HttpDispatcher->ReleaseOwner(this);
+        HttpDispatcher.Reset();
+    }
+
+    if (bPersistLedgerMirror && !bLedgerLoading && LedgerMirror->Num() > 0)
+    {
+        SaveLedgerMirror();
+    }
     Super::EndPlay(EndPlayReason);
 }
 
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> UInterverseChainComponent::CreateChainRequest(const FString& Verb, const FString& Path)
+{
+    if (!HttpDispatcher.IsValid() || !HttpDispatcher->IsConfiguredFor(NodeUrl, ApiKey))
+    {
+        if (HttpDispatcher.IsValid())
+        {
+            HttpDispatcher->ReleaseOwner(this);
+        }
+        HttpDispatcher = FInterverseHttpDispatcher::Acquire(NodeUrl, ApiKey);
+    }
+
+    HttpDispatcher->Configure(NodeUrl, ApiKey, MaxConcurrentRequests);
+    return HttpDispatcher->CreateRequest(Verb, Path);
+}
+
+void UInterverseChainComponent::SubmitChainRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, EInterverseRequestPriority Priority)
+{
+    HttpDispatcher->Submit(Request, Priority, this);
+}
+
+void UInterverseChainComponent::SetRequestBody(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const TSharedRef<FJsonObject>& Body) const
+{
+    // MessagePack only for nodes that advertised it for HTTP; responses stay JSON
+    if (GetHttpWireFormat() == EInterverseWireFormat::MessagePack)
+    {
+        TArray<uint8> Packed;
+        InterverseWire::ToMessagePack(Body, Packed);
+        Request->SetHeader(TEXT("Content-Type"), InterverseWire::GetContentType(EInterverseWireFormat::MessagePack));
+        Request->SetContent(MoveTemp(Packed));
+        return;
+    }
+
+    Request->SetContentAsString(InterverseWire::ToJsonString(Body));
+}
+
+FInterverseHttpStats UInterverseChainComponent::GetHttpStats() const
+{
+    return HttpDispatcher.IsValid() ? HttpDispatcher->GetStats() : FInterverseHttpStats();
+}
+
 void UInterverseChainComponent::CreateWallet()
 {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived);
-    
     // Use compatibility layer for endpoint
     FString Endpoint = InterverseCompat::GetEndpointPath("wallet/create");
-    Request->SetURL(FString::Printf(TEXT("%s/%s"), *NodeUrl, *Endpoint));
-    
-    Request->SetVerb("POST");
-    Request->SetHeader("Content-Type", "application/json");
-    Request->SetHeader("X-API-Key", ApiKey);
-    Request->ProcessRequest();
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("POST"), Endpoint);
+    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived, FHttpPayloadDecoder(nullptr));
+    SubmitChainRequest(Request, EInterverseRequestPriority::Normal);
 }
 
 void UInterverseChainComponent::GetBalance(const FString& Address)
+{
+    GetBalance(Address, FOnBalanceQueried());
+}
+
+void UInterverseChainComponent::GetBalance(const FString& Address, FOnBalanceQueried OnComplete)
 {
     if (Address.IsEmpty()) return;
 
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived);
-    
+    if (const FCachedBalance* Cached = BalanceCache.Find(Address))
+    {
+        if (IsCacheEntryFresh(Cached->Timestamp))
+        {
+            // Answer on a later tick, like a fetched result, so callers never re-enter from inside the call
+            TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Balance = Cached->Balance, OnComplete = MoveTemp(OnComplete)]()
+            {
+                if (OnComplete)
+                {
+                    OnComplete(true, Balance);
+                }
+                if (UInterverseChainComponent* This = WeakThis.Get())
+                {
+                    This->OnBalanceUpdated.Broadcast(Balance);
+                }
+            });
+            return;
+        }
+    }
+
+    // Join a request that is already on its way for this address
+    if (TArray<FOnBalanceQueried>* Waiters = InFlightBalanceQueries.Find(Address))
+    {
+        Waiters->Add(MoveTemp(OnComplete));
+        return;
+    }
+    InFlightBalanceQueries.Add(Address).Add(MoveTemp(OnComplete));
+
     FString Endpoint = InterverseCompat::GetEndpointPath(FString::Printf(TEXT("wallet/%s/balance"), *Address));
-    Request->SetURL(FString::Printf(TEXT("%s/%s"), *NodeUrl, *Endpoint));
-    
-    Request->SetVerb("GET");
-    Request->SetHeader("X-API-Key", ApiKey);
-    Request->ProcessRequest();
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("GET"), Endpoint);
+    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnBalanceResponse, Address, BalancePushGeneration);
+    SubmitChainRequest(Request, EInterverseRequestPriority::High);
 }
 
 void UInterverseChainComponent::MintGameAsset(
@@ -73,27 +439,21 @@ void UInterverseChainComponent::MintGameAsset(
         return;
     }
 
+    AssetCache.Remove(OwnerAddress);
+    AssetPushGeneration++;
+
     // Use compatibility layer to convert properties
     TSharedPtr<FJsonObject> AssetJson = InterverseCompat::ConvertAssetToJson(Properties, CustomProperties);
     AssetJson->SetStringField("owner", OwnerAddress);
     AssetJson->SetStringField("game_id", GameId);
     
-    // Convert to string
-    FString RequestBody;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-    FJsonSerializer::Serialize(AssetJson.ToSharedRef(), Writer);
-    
     // Use compatibility layer for endpoint
     FString Endpoint = InterverseCompat::GetEndpointPath("assets/mint");
     
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived);
-    Request->SetURL(FString::Printf(TEXT("%s/%s"), *NodeUrl, *Endpoint));
-    Request->SetVerb("POST");
-    Request->SetHeader("Content-Type", "application/json");
-    Request->SetHeader("X-API-Key", ApiKey);
-    Request->SetContentAsString(RequestBody);
-    Request->ProcessRequest();
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("POST"), Endpoint);
+    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived, &DecodeMintResponse);
+    SetRequestBody(Request, AssetJson.ToSharedRef());
+    SubmitChainRequest(Request, EInterverseRequestPriority::Normal);
 }
 
 void UInterverseChainComponent::TransferAsset(
@@ -103,389 +463,1311 @@ void UInterverseChainComponent::TransferAsset(
 {
     if (AssetId.IsEmpty() || FromAddress.IsEmpty() || ToAddress.IsEmpty()) return;
 
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    AssetCache.Remove(FromAddress);
+    AssetCache.Remove(ToAddress);
+    AssetPushGeneration++;
+
+    TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
     JsonObject->SetStringField("asset_id", AssetId);
     JsonObject->SetStringField("from_address", FromAddress);
     JsonObject->SetStringField("to_address", ToAddress);
     
-    FString RequestBody;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-    
     FString Endpoint = InterverseCompat::GetEndpointPath("assets/transfer");
     
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived);
-    Request->SetURL(FString::Printf(TEXT("%s/%s"), *NodeUrl, *Endpoint));
-    Request->SetVerb("POST");
-    Request->SetHeader("Content-Type", "application/json");
-    Request->SetHeader("X-API-Key", ApiKey);
-    Request->SetContentAsString(RequestBody);
-    Request->ProcessRequest();
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("POST"), Endpoint);
+    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived, &DecodeTransferResponse);
+    SetRequestBody(Request, JsonObject);
+    SubmitChainRequest(Request, EInterverseRequestPriority::Normal);
 }
 
 void UInterverseChainComponent::GetPlayerAssets(const FString& PlayerAddress)
 {
-    if (PlayerAddress.IsEmpty()) return;
-
-    FString Endpoint = InterverseCompat::GetEndpointPath(FString::Printf(TEXT("assets/player/%s"), *PlayerAddress));
-    
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived);
-    Request->SetURL(FString::Printf(TEXT("%s/%s"), *NodeUrl, *Endpoint));
-    Request->SetVerb("GET");
-    Request->SetHeader("X-API-Key", ApiKey);
-    Request->ProcessRequest();
+    GetPlayerAssets(PlayerAddress, FOnPlayerAssetsQueried());
 }
 
-void UInterverseChainComponent::ConnectWebSocket()
+void UInterverseChainComponent::GetPlayerAssets(const FString& PlayerAddress, FOnPlayerAssetsQueried OnComplete)
 {
-    // Load WebSocket module for UE5
-    const FName WebSocketModuleName = TEXT("WebSockets");
-    if (!FModuleManager::Get().IsModuleLoaded(WebSocketModuleName))
+    if (PlayerAddress.IsEmpty()) return;
+
+    if (const FCachedAssets* Cached = AssetCache.Find(PlayerAddress))
     {
-        FModuleManager::Get().LoadModule(WebSocketModuleName);
-        if (!FModuleManager::Get().IsModuleLoaded(WebSocketModuleName))
+        if (IsCacheEntryFresh(Cached->Timestamp))
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to load WebSockets module"));
+            TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+            TArray<FInterverseAsset> Assets;
+            Cached->Expand(Assets);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, PlayerAddress, Assets = MoveTemp(Assets), OnComplete = MoveTemp(OnComplete)]()
+            {
+                if (OnComplete)
+                {
+                    OnComplete(true, Assets);
+                }
+                if (UInterverseChainComponent* This = WeakThis.Get())
+                {
+                    This->OnPlayerAssetsReceived.Broadcast(PlayerAddress, Assets);
+                }
+            });
             return;
         }
     }
 
-    // Validate configuration
-    if (NodeUrl.IsEmpty() || ApiKey.IsEmpty())
+    if (TArray<FOnPlayerAssetsQueried>* Waiters = InFlightAssetQueries.Find(PlayerAddress))
     {
-        UE_LOG(LogTemp, Error, TEXT("NodeUrl or ApiKey is empty"));
+        Waiters->Add(MoveTemp(OnComplete));
         return;
     }
+    InFlightAssetQueries.Add(PlayerAddress).Add(MoveTemp(OnComplete));
 
-    // Construct WebSocket URL for UE5
-    FString WsUrl = NodeUrl;
-    WsUrl.ReplaceInline(TEXT("http://"), TEXT("ws://"));
-    WsUrl.ReplaceInline(TEXT("https://"), TEXT("wss://"));
-    
-    // Remove any trailing slashes for UE5
-    while (WsUrl.EndsWith(TEXT("/")))
-    {
-        WsUrl.LeftChopInline(1);
-    }
-    
-    // Add /ws endpoint and API key
-    WsUrl = FString::Printf(TEXT("%s/ws?api_key=%s"), *WsUrl, *ApiKey);
+    FString Endpoint = InterverseCompat::GetEndpointPath(FString::Printf(TEXT("assets/player/%s"), *PlayerAddress));
     
-    UE_LOG(LogTemp, Log, TEXT("UE5 Connecting to WebSocket URL: %s"), *WsUrl);
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("GET"), Endpoint);
+    Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnPlayerAssetsResponse, PlayerAddress, AssetPushGeneration);
+    SubmitChainRequest(Request, EInterverseRequestPriority::High);
+}
+
+void UInterverseChainComponent::StreamPlayerAssets(const FString& PlayerAddress, int32 ChunkSize, FOnAssetChunk OnChunk, FOnListStreamComplete OnComplete)
+{
+    if (PlayerAddress.IsEmpty()) return;
 
-    // UE5 specific headers
-    TMap<FString, FString> Headers;
-    Headers.Add(TEXT("Sec-WebSocket-Protocol"), TEXT("verse-protocol"));
-    Headers.Add(TEXT("Upgrade"), TEXT("websocket"));
-    Headers.Add(TEXT("Connection"), TEXT("Upgrade"));
-    Headers.Add(TEXT("Sec-WebSocket-Version"), TEXT("13"));
+    FString Endpoint = InterverseCompat::GetEndpointPath(FString::Printf(TEXT("assets/player/%s"), *PlayerAddress));
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("GET"), Endpoint);
 
-    // Create WebSocket with UE5's implementation
-    WebSocket = FWebSocketsModule::Get().CreateWebSocket(WsUrl, TEXT("verse-protocol"), Headers);
-    
-    if (!WebSocket.IsValid())
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    TSharedRef<FOnAssetChunk> SharedOnChunk = MakeShared<FOnAssetChunk>(MoveTemp(OnChunk));
+    Request->OnProcessRequestComplete().BindLambda([WeakThis, SharedOnChunk, ChunkSize, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to create WebSocket in UE5"));
-        return;
-    }
-
-    // UE5 connection handler with improved lambda capture
-    WebSocket->OnConnected().AddLambda([this, WsUrl]() {
-        UE_LOG(LogTemp, Log, TEXT("UE5 WebSocket Connected to: %s"), *WsUrl);
-        
-        // Use UE5's task graph for game thread execution
-        FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-            FSimpleDelegateGraphTask::FDelegate::CreateLambda([this]()
+        StreamListResponse<FInterverseAsset>(WeakThis, Response, bSuccess, SharedOnChunk, OnComplete,
+            [ChunkSize](const FString& Content, TFunctionRef<void(TArray<FInterverseAsset>&&)> Emit)
             {
-                OnWebSocketConnected.Broadcast(true);
-            }),
-            TStatId(),
-            nullptr,
-            ENamedThreads::GameThread
-        );
-        
-        // Send initial handshake
-        if (!GameId.IsEmpty())
-        {
-            const FString HandshakeMessage = FString::Printf(TEXT("{\"type\":\"handshake\",\"game_id\":\"%s\"}"), *GameId);
-            WebSocket->Send(HandshakeMessage);
-            UE_LOG(LogTemp, Log, TEXT("Sent UE5 handshake: %s"), *HandshakeMessage);
-        }
-    });
-
-    // UE5 error handler
-    WebSocket->OnConnectionError().AddLambda([this](const FString& Error) {
-        UE_LOG(LogTemp, Error, TEXT("UE5 WebSocket Connection Error: %s"), *Error);
-        
-        FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-            FSimpleDelegateGraphTask::FDelegate::CreateLambda([this]()
-            {
-                OnWebSocketConnected.Broadcast(false);
-            }),
-            TStatId(),
-            nullptr,
-            ENamedThreads::GameThread
-        );
-    });
-
-    // UE5 message handler with improved type safety
-    WebSocket->OnMessage().AddLambda([this](const FString& MessageStr) {
-        UE_LOG(LogTemp, Verbose, TEXT("UE5 Received WebSocket message: %s"), *MessageStr);
-        
-        FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-            FSimpleDelegateGraphTask::FDelegate::CreateLambda([this, MessageStr]()
-            {
-                OnWebSocketMessage.Broadcast(MessageStr);
-                ProcessWebSocketMessage(MessageStr);
-            }),
-            TStatId(),
-            nullptr,
-            ENamedThreads::GameThread
-        );
+                return FInterverseJsonListReader::ReadAssets(Content, ChunkSize, Emit);
+            });
     });
 
-    // UE5 close handler with status code
-    WebSocket->OnClosed().AddLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean) {
-        UE_LOG(LogTemp, Warning, TEXT("UE5 WebSocket Closed - Status: %d, Reason: %s, Clean: %d"), 
-            StatusCode, *Reason, bWasClean);
-            
-        // Optionally attempt reconnection if wasn't a clean close
-        if (!bWasClean)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("UE5 WebSocket connection was not clean, scheduling reconnect"));
-            // Schedule reconnection attempt after delay
-            FTimerHandle ReconnectTimerHandle;
-            GetWorld()->GetTimerManager().SetTimer(
-                ReconnectTimerHandle,
-                this,
-                &UInterverseChainComponent::ReconnectWebSocket,
-                5.0f,  // 5 second delay
-                false
-            );
-        }
-    });
+    SubmitChainRequest(Request, EInterverseRequestPriority::High);
+}
 
-    UE_LOG(LogTemp, Log, TEXT("UE5 Initiating WebSocket connection"));
-    WebSocket->Connect();
+void UInterverseChainComponent::InvalidateResponseCache(const FString& Address)
+{
+    BalanceCache.Remove(Address);
+    AssetCache.Remove(Address);
+    BalancePushGeneration++;
+    AssetPushGeneration++;
 }
 
-void UInterverseChainComponent::DisconnectWebSocket()
+bool UInterverseChainComponent::IsCacheEntryFresh(double Timestamp) const
 {
-    if (WebSocket.IsValid() && WebSocket->IsConnected())
-    {
-        UE_LOG(LogTemp, Log, TEXT("Disconnecting WebSocket"));
-        WebSocket->Close();
-    }
+    return ResponseCacheTTL > 0.0f && FPlatformTime::Seconds() - Timestamp < ResponseCacheTTL;
 }
 
-void UInterverseChainComponent::OnHttpResponseReceived(
-    FHttpRequestPtr Request,
-    FHttpResponsePtr Response,
-    bool bSuccess)
+void UInterverseChainComponent::OnBalanceResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess, FString Address, uint64 IssuedGeneration)
 {
     if (!bSuccess || !Response.IsValid())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Failed to receive response"));
+        CompleteBalanceQuery(Address, false, 0.0f, IssuedGeneration);
         return;
     }
 
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-
-    if (FJsonSerializer::Deserialize(Reader, JsonObject))
+    // Body conversion and parsing stay off the game thread
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Response, Address, IssuedGeneration]()
     {
-        FString URL = Request->GetURL();
-        
-        // Get the data object which contains the actual response
-        const TSharedPtr<FJsonObject>* DataObject;
-        if (!JsonObject->TryGetObjectField("data", DataObject))
+        float Balance = 0.0f;
+        bool bParsed = false;
         {
-            UE_LOG(LogTemp, Warning, TEXT("Response missing data field"));
-            return;
+            SCOPE_CYCLE_COUNTER(STAT_InterverseDecodePayload);
+            bParsed = DecodeBalancePayload(Response->GetContentAsString(), Balance);
         }
 
-        if (URL.Contains(TEXT("assets/mint")))
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Address, bParsed, Balance, IssuedGeneration]()
         {
-            FInterverseAsset Asset;
-            if (InterverseCompat::ConvertJsonToAsset(*DataObject, Asset))
+            if (UInterverseChainComponent* This = WeakThis.Get())
             {
-                AsyncTask(ENamedThreads::GameThread, [this, Asset]() {
-                    OnAssetMinted.Broadcast(Asset, TEXT(""));
-                });
+                This->CompleteBalanceQuery(Address, bParsed, Balance, IssuedGeneration);
             }
-        }
-        else if (URL.Contains(TEXT("assets/transfer")))
-        {
-            const FString AssetId = (*DataObject)->GetStringField("asset_id");
-            const bool Success = JsonObject->GetBoolField("success");
-            
-            AsyncTask(ENamedThreads::GameThread, [this, AssetId, Success]() {
-            OnTransferComplete.Broadcast(AssetId, TEXT(""), Success);  
+        });
     });
-        }
-        else if (URL.Contains(TEXT("wallet/balance")))
-        {
-            const float Balance = (*DataObject)->GetNumberField("balance");
-            
-            AsyncTask(ENamedThreads::GameThread, [this, Balance]() {
-                OnBalanceUpdated.Broadcast(Balance);
-            });
-        }
-    }
 }
 
-void UInterverseChainComponent::ProcessWebSocketMessage(const FString& Message)
+void UInterverseChainComponent::OnPlayerAssetsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess, FString Address, uint64 IssuedGeneration)
 {
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    if (!bSuccess || !Response.IsValid())
+    {
+        CompletePlayerAssetsQuery(Address, false, TArray<FInterverseAsset>(), IssuedGeneration);
+        return;
+    }
 
-    if (FJsonSerializer::Deserialize(Reader, JsonObject))
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Response, Address, IssuedGeneration]()
     {
-        const FString MessageType = JsonObject->GetStringField("type");
+        TArray<FInterverseAsset> Assets;
+        bool bParsed = false;
+        {
+            SCOPE_CYCLE_COUNTER(STAT_InterverseDecodePayload);
+            bParsed = DecodeAssetListPayload(Response->GetContentAsString(), Assets);
+        }
 
-        if (MessageType == "asset_update")
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Address, bParsed, Assets = MoveTemp(Assets), IssuedGeneration]()
         {
-            const TSharedPtr<FJsonObject>* AssetObject;
-            if (JsonObject->TryGetObjectField("asset", AssetObject))
+            if (UInterverseChainComponent* This = WeakThis.Get())
             {
-                FInterverseAsset Asset;
-                if (InterverseCompat::ConvertJsonToAsset(*AssetObject, Asset))
-                {
-                    AsyncTask(ENamedThreads::GameThread, [this, Asset]() {
-                        OnAssetMinted.Broadcast(Asset, TEXT(""));
-                    });
-                }
+                This->CompletePlayerAssetsQuery(Address, bParsed, Assets, IssuedGeneration);
+            }
+        });
+    });
+}
+
+void UInterverseChainComponent::CompleteBalanceQuery(const FString& Address, bool bParsed, float Balance, uint64 IssuedGeneration)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseApplyPayload);
+
+    TArray<FOnBalanceQueried> Waiters;
+    InFlightBalanceQueries.RemoveAndCopyValue(Address, Waiters);
+
+    if (bParsed && IssuedGeneration == BalancePushGeneration)
+    {
+        UpdateCachedBalance(Address, Balance);
+    }
+    else if (bParsed)
+    {
+        // A push landed while this was in flight; prefer what it wrote, and never cache the older reply
+        if (const FCachedBalance* Pushed = BalanceCache.Find(Address))
+        {
+            if (Pushed->Generation > IssuedGeneration)
+            {
+                Balance = Pushed->Balance;
+            }
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to fetch balance for %s"), *Address);
+    }
+
+    for (FOnBalanceQueried& Waiter : Waiters)
+    {
+        if (Waiter)
+        {
+            Waiter(bParsed, Balance);
+        }
+    }
+
+    if (bParsed)
+    {
+        OnBalanceUpdated.Broadcast(Balance);
+    }
+}
+
+void UInterverseChainComponent::CompletePlayerAssetsQuery(const FString& Address, bool bParsed, const TArray<FInterverseAsset>& Assets, uint64 IssuedGeneration)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseApplyPayload);
+
+    TArray<FOnPlayerAssetsQueried> Waiters;
+    InFlightAssetQueries.RemoveAndCopyValue(Address, Waiters);
+
+    // A list fetched before the latest push or local write may miss that change, so it is
+    // handed to the waiters but not cached; the next query fetches again
+    if (bParsed && IssuedGeneration == AssetPushGeneration)
+    {
+        FCachedAssets& Cached = AssetCache.FindOrAdd(Address);
+        Cached.Store(Assets, bCompactAssetCache);
+        Cached.Timestamp = FPlatformTime::Seconds();
+        Cached.Generation = AssetPushGeneration;
+    }
+    else if (!bParsed)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to fetch assets for %s"), *Address);
+    }
+
+    for (FOnPlayerAssetsQueried& Waiter : Waiters)
+    {
+        if (Waiter)
+        {
+            Waiter(bParsed, Assets);
+        }
+    }
+
+    if (bParsed)
+    {
+        OnPlayerAssetsReceived.Broadcast(Address, Assets);
+    }
+}
+
+void UInterverseChainComponent::FCachedAssets::Store(const TArray<FInterverseAsset>& InAssets, bool bInCompact)
+{
+    bCompact = bInCompact;
+    Assets.Reset();
+    CompactAssets.Reset();
+    if (bCompact)
+    {
+        CompactAssets.Reserve(InAssets.Num());
+        for (const FInterverseAsset& Asset : InAssets)
+        {
+            CompactAssets.Add(FInterverseCompactAsset::FromAsset(Asset));
+        }
+    }
+    else
+    {
+        Assets = InAssets;
+    }
+}
+
+void UInterverseChainComponent::FCachedAssets::Expand(TArray<FInterverseAsset>& OutAssets) const
+{
+    if (!bCompact)
+    {
+        OutAssets = Assets;
+        return;
+    }
+
+    OutAssets.Reset(CompactAssets.Num());
+    for (const FInterverseCompactAsset& Compact : CompactAssets)
+    {
+        OutAssets.Add(Compact.ToAsset());
+    }
+}
+
+int32 UInterverseChainComponent::FCachedAssets::IndexOf(const FString& AssetId) const
+{
+    return bCompact
+        ? CompactAssets.IndexOfByPredicate([&AssetId](const FInterverseCompactAsset& Cached) { return Cached.AssetId == AssetId; })
+        : Assets.IndexOfByPredicate([&AssetId](const FInterverseAsset& Cached) { return Cached.AssetId == AssetId; });
+}
+
+void UInterverseChainComponent::FCachedAssets::Put(int32 Index, const FInterverseAsset& Asset)
+{
+    if (bCompact)
+    {
+        FInterverseCompactAsset Compact = FInterverseCompactAsset::FromAsset(Asset);
+        if (CompactAssets.IsValidIndex(Index))
+        {
+            CompactAssets[Index] = MoveTemp(Compact);
+        }
+        else
+        {
+            CompactAssets.Add(MoveTemp(Compact));
+        }
+    }
+    else if (Assets.IsValidIndex(Index))
+    {
+        Assets[Index] = Asset;
+    }
+    else
+    {
+        Assets.Add(Asset);
+    }
+}
+
+void UInterverseChainComponent::FCachedAssets::RemoveAt(int32 Index)
+{
+    if (bCompact)
+    {
+        CompactAssets.RemoveAt(Index);
+    }
+    else
+    {
+        Assets.RemoveAt(Index);
+    }
+}
+
+void UInterverseChainComponent::UpdateCachedBalance(const FString& Address, float Balance)
+{
+    FCachedBalance& Cached = BalanceCache.FindOrAdd(Address);
+    Cached.Balance = Balance;
+    Cached.Timestamp = FPlatformTime::Seconds();
+    Cached.Generation = BalancePushGeneration;
+}
+
+void UInterverseChainComponent::UpdateCachedAsset(const FInterverseAsset& Asset)
+{
+    // Patch the owner's cached list in place and drop the asset from anyone else's
+    AssetPushGeneration++;
+    for (TPair<FString, FCachedAssets>& Pair : AssetCache)
+    {
+        Pair.Value.Generation = AssetPushGeneration;
+
+        const int32 Index = Pair.Value.IndexOf(Asset.AssetId);
+        if (Pair.Key == Asset.Owner)
+        {
+            Pair.Value.Put(Index, Asset);
+        }
+        else if (Index != INDEX_NONE)
+        {
+            Pair.Value.RemoveAt(Index);
+        }
+    }
+}
+
+void UInterverseChainComponent::InvalidateCachedAsset(const FString& AssetId)
+{
+    AssetPushGeneration++;
+    for (auto It = AssetCache.CreateIterator(); It; ++It)
+    {
+        if (It->Value.IndexOf(AssetId) != INDEX_NONE)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void UInterverseChainComponent::ConnectWebSocket()
+{
+    if (SocketConnection.IsValid())
+    {
+        SocketConnection->Connect();
+        return;
+    }
+
+    // Every component talking to the same node for the same game shares one socket and one handshake
+    SocketConnection = FInterverseConnectionManager::Get().Acquire(NodeUrl, ApiKey, GameId, ReconnectDelay, MaxReconnectDelay, SendQueueSettings, PreferredWireFormat);
+
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+
+    FInterverseSocketSubscriber Subscriber;
+    Subscriber.Owner = this;
+    Subscriber.Addresses = SubscribedAddresses;
+    Subscriber.AssetIds = SubscribedAssetIds;
+    Subscriber.OnConnected = [WeakThis](bool bConnected)
+    {
+        if (UInterverseChainComponent* This = WeakThis.Get())
+        {
+            This->OnWebSocketConnected.Broadcast(bConnected);
+        }
+    };
+    Subscriber.OnMessage = [WeakThis](const FInterverseDecodedPayload& Payload)
+    {
+        if (UInterverseChainComponent* This = WeakThis.Get())
+        {
+            This->OnWebSocketMessage.Broadcast(Payload.RawMessage);
+            This->ApplyDecodedPayload(Payload);
+        }
+    };
+
+    SocketSubscriberHandle = SocketConnection->AddSubscriber(MoveTemp(Subscriber));
+    SocketConnection->Connect();
+}
+
+void UInterverseChainComponent::DisconnectWebSocket()
+{
+    if (!SocketConnection.IsValid())
+    {
+        return;
+    }
+
+    SocketConnection->RemoveSubscriber(SocketSubscriberHandle);
+    SocketSubscriberHandle = INDEX_NONE;
+
+    // The socket itself only closes once its last subscriber leaves
+    FInterverseConnectionManager::Get().Release(SocketConnection);
+    SocketConnection.Reset();
+}
+
+void UInterverseChainComponent::OnHttpResponseReceived(
+    FHttpRequestPtr Request,
+    FHttpResponsePtr Response,
+    bool bSuccess,
+    FHttpPayloadDecoder Decoder)
+{
+    if (!bSuccess || !Response.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to receive response"));
+        return;
+    }
+
+    if (!Decoder)
+    {
+        return;
+    }
+
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Response, Decoder]()
+    {
+        TSharedPtr<FInterverseDecodedPayload> Payload = MakeShared<FInterverseDecodedPayload>();
+        {
+            SCOPE_CYCLE_COUNTER(STAT_InterverseDecodePayload);
+            TSharedPtr<FJsonObject> JsonObject = ParseJsonObject(Response->GetContentAsString());
+            Payload->bValid = JsonObject.IsValid() && Decoder(*JsonObject, *Payload);
+        }
+
+        if (!Payload->bValid)
+        {
+            return;
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Payload]()
+        {
+            if (UInterverseChainComponent* This = WeakThis.Get())
+            {
+                This->ApplyDecodedPayload(*Payload);
+            }
+        });
+    });
+}
+
+void UInterverseChainComponent::ApplyDecodedPayload(const FInterverseDecodedPayload& Payload)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseApplyPayload);
+
+    if (!Payload.bValid)
+    {
+        return;
+    }
+
+    // One hash lookup on the interned type instead of a chain of string compares
+    if (const FInterverseMessageHandler* Handler = MessageHandlers.Find(Payload.Type))
+    {
+        (*Handler)(Payload);
+    }
+}
+
+void UInterverseChainComponent::RecordTransaction(const FString& TransactionData)
+{
+    RecordTransaction(TransactionData, FOnTransactionRecorded());
+}
+
+void UInterverseChainComponent::RecordTransaction(const FString& TransactionData, FOnTransactionRecorded OnComplete)
+{
+    if (TransactionData.IsEmpty())
+    {
+        if (OnComplete)
+        {
+            OnComplete(false, TEXT(""));
+        }
+        return;
+    }
+
+    FPendingTransaction Pending;
+    Pending.Data = TransactionData;
+    Pending.bDataIsJson = IsJsonDocument(TransactionData);
+    Pending.OnComplete = MoveTemp(OnComplete);
+    QueuePendingTransaction(MoveTemp(Pending), TransactionData.Len());
+}
+
+void UInterverseChainComponent::RecordTransaction(const TSharedRef<FJsonObject>& Record, FOnTransactionRecorded OnComplete)
+{
+    if (GetHttpWireFormat() != EInterverseWireFormat::MessagePack)
+    {
+        RecordTransaction(InterverseWire::ToJsonString(Record), MoveTemp(OnComplete));
+        return;
+    }
+
+    FPendingTransaction Pending;
+    InterverseWire::ToMessagePack(Record, Pending.Packed);
+    Pending.Object = Record;
+    Pending.OnComplete = MoveTemp(OnComplete);
+
+    const int32 Bytes = Pending.Packed.Num();
+    QueuePendingTransaction(MoveTemp(Pending), Bytes);
+}
+
+void UInterverseChainComponent::QueuePendingTransaction(FPendingTransaction&& Pending, int32 Bytes)
+{
+    PendingTransactions.Add(MoveTemp(Pending));
+    PendingTransactionBytes += Bytes;
+    BatchStats.PendingRecords = PendingTransactions.Num();
+
+    UWorld* World = GetWorld();
+    if (!bBatchTransactions || !World ||
+        PendingTransactions.Num() >= MaxBatchRecords ||
+        PendingTransactionBytes >= MaxBatchBytes)
+    {
+        FlushTransactionBatch();
+        return;
+    }
+
+    // Time threshold starts with the first record of a batch
+    if (!World->GetTimerManager().IsTimerActive(BatchFlushTimerHandle))
+    {
+        World->GetTimerManager().SetTimer(
+            BatchFlushTimerHandle,
+            this,
+            &UInterverseChainComponent::FlushTransactionBatch,
+            FMath::Max(BatchFlushInterval, KINDA_SMALL_NUMBER),
+            false
+        );
+    }
+}
+
+void UInterverseChainComponent::FlushTransactionBatch()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(BatchFlushTimerHandle);
+    }
+
+    if (PendingTransactions.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FPendingTransaction> Batch = MoveTemp(PendingTransactions);
+    PendingTransactions.Reset();
+    PendingTransactionBytes = 0;
+    BatchStats.PendingRecords = 0;
+
+    SendTransactionBatch(MoveTemp(Batch));
+}
+
+void UInterverseChainComponent::SendTransactionBatch(TArray<FPendingTransaction>&& Batch)
+{
+    // Binary only when every record was packed and the node still takes it; otherwise all go as JSON
+    const bool bPacked = GetHttpWireFormat() == EInterverseWireFormat::MessagePack &&
+        Algo::AllOf(Batch, [](const FPendingTransaction& Pending) { return Pending.Packed.Num() > 0; });
+
+    auto GetRecordText = [](const FPendingTransaction& Pending)
+    {
+        return Pending.Object.IsValid() ? InterverseWire::ToJsonString(Pending.Object.ToSharedRef()) : Pending.Data;
+    };
+
+    FString Endpoint;
+    FString RequestBody;
+    TArray<uint8> PackedBody;
+
+    if (Batch.Num() == 1)
+    {
+        // A lone record keeps using the single-record endpoint
+        Endpoint = InterverseCompat::GetEndpointPath(TEXT("transactions/record"));
+        if (bPacked)
+        {
+            PackedBody = Batch[0].Packed;
+        }
+        else
+        {
+            RequestBody = GetRecordText(Batch[0]);
+        }
+    }
+    else if (bPacked)
+    {
+        Endpoint = InterverseCompat::GetEndpointPath(TEXT("transactions/batch"));
+
+        // Records are already encoded, so splice them into the array
+        InterverseWire::AppendMapHeader(PackedBody, 1);
+        InterverseWire::AppendString(PackedBody, TEXT("transactions"));
+        InterverseWire::AppendArrayHeader(PackedBody, Batch.Num());
+        for (const FPendingTransaction& Pending : Batch)
+        {
+            PackedBody.Append(Pending.Packed);
+        }
+    }
+    else
+    {
+        Endpoint = InterverseCompat::GetEndpointPath(TEXT("transactions/batch"));
+
+        // Records are already serialized, so splice them into the array instead of re-parsing
+        RequestBody.Reserve(Batch.Num() * (Batch[0].Data.Len() + 1) + 32);
+        RequestBody += TEXT("{\"transactions\":[");
+        for (int32 Index = 0; Index < Batch.Num(); ++Index)
+        {
+            if (Index > 0)
+            {
+                RequestBody += TEXT(",");
+            }
+
+            const FPendingTransaction& Pending = Batch[Index];
+            if (Pending.Object.IsValid())
+            {
+                RequestBody += InterverseWire::ToJsonString(Pending.Object.ToSharedRef());
+            }
+            else if (Pending.bDataIsJson)
+            {
+                RequestBody += Pending.Data;
+            }
+            else
+            {
+                // Plain text, and anything that only looked like JSON, travels as a JSON string
+                AppendJsonString(RequestBody, Pending.Data);
+            }
+        }
+        RequestBody += TEXT("]}");
+    }
+
+    BatchStats.BatchesFlushed++;
+    BatchStats.RecordsFlushed += Batch.Num();
+    BatchStats.LastBatchSize = Batch.Num();
+    BatchStats.LargestBatchSize = FMath::Max(BatchStats.LargestBatchSize, Batch.Num());
+
+    const double SendTime = FPlatformTime::Seconds();
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("POST"), Endpoint);
+    Request->OnProcessRequestComplete().BindWeakLambda(this,
+        [this, Batch = MoveTemp(Batch), SendTime](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) mutable
+        {
+            OnTransactionBatchResponse(Response, bSuccess, MoveTemp(Batch), SendTime);
+        });
+    if (bPacked)
+    {
+        Request->SetHeader(TEXT("Content-Type"), InterverseWire::GetContentType(EInterverseWireFormat::MessagePack));
+        Request->SetContent(MoveTemp(PackedBody));
+    }
+    else
+    {
+        Request->SetContentAsString(RequestBody);
+    }
+    SubmitChainRequest(Request, EInterverseRequestPriority::Low);
+}
+
+void UInterverseChainComponent::OnTransactionBatchResponse(
+    FHttpResponsePtr Response,
+    bool bSuccess,
+    TArray<FPendingTransaction> Batch,
+    double SendTime)
+{
+    const float LatencyMs = static_cast<float>((FPlatformTime::Seconds() - SendTime) * 1000.0);
+    BatchStats.BatchesCompleted++;
+    BatchStats.LastFlushLatencyMs = LatencyMs;
+    BatchStats.AverageFlushLatencyMs += (LatencyMs - BatchStats.AverageFlushLatencyMs) / BatchStats.BatchesCompleted;
+
+    const bool bRequestOk = bSuccess && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+    if (!bRequestOk)
+    {
+        BatchStats.FailedBatches++;
+        UE_LOG(LogTemp, Warning, TEXT("Failed to record batch of %d transactions"), Batch.Num());
+
+        for (FPendingTransaction& Pending : Batch)
+        {
+            if (Pending.OnComplete)
+            {
+                Pending.OnComplete(false, TEXT(""));
+            }
+        }
+        return;
+    }
+
+    const FString Content = Response->GetContentAsString();
+
+    // A single record was sent to the plain endpoint, so the whole body is its result
+    if (Batch.Num() == 1)
+    {
+        if (Batch[0].OnComplete)
+        {
+            Batch[0].OnComplete(true, Content);
+        }
+        return;
+    }
+
+    // Split the node's per-record results back onto the queued callbacks
+    const TArray<TSharedPtr<FJsonValue>>* Results = nullptr;
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+    if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+    {
+        const TSharedPtr<FJsonObject>* DataObject;
+        if (JsonObject->TryGetObjectField(TEXT("data"), DataObject))
+        {
+            (*DataObject)->TryGetArrayField(TEXT("results"), Results);
+        }
+        if (!Results)
+        {
+            JsonObject->TryGetArrayField(TEXT("results"), Results);
+        }
+    }
+
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        if (!Batch[Index].OnComplete)
+        {
+            continue;
+        }
+
+        // Without a result for this record the node never confirmed it
+        if (!Results || !Results->IsValidIndex(Index))
+        {
+            Batch[Index].OnComplete(false, TEXT(""));
+            continue;
+        }
+
+        const TSharedPtr<FJsonValue>& ResultValue = (*Results)[Index];
+        bool bRecordSuccess = true;
+        FString ResultString;
+
+        const TSharedPtr<FJsonObject>* ResultObject;
+        if (ResultValue.IsValid() && ResultValue->TryGetObject(ResultObject))
+        {
+            (*ResultObject)->TryGetBoolField(TEXT("success"), bRecordSuccess);
+            TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
+            FJsonSerializer::Serialize(ResultObject->ToSharedRef(), Writer);
+        }
+        else if (ResultValue.IsValid())
+        {
+            ResultString = ResultValue->AsString();
+        }
+
+        Batch[Index].OnComplete(bRecordSuccess, ResultString);
+    }
+}
+
+void UInterverseChainComponent::GetLedgerState(FString& OutLedgerState)
+{
+    // Answer from the mirror; the request can't write into OutLedgerState after we return
+    OutLedgerState = LedgerMirror->ToJsonString();
+    SyncLedger();
+}
+
+void UInterverseChainComponent::SyncLedger()
+{
+    if (bLedgerLoading || bLedgerSyncing)
+    {
+        // Picked up once the load or the running sync finishes
+        bLedgerSyncPending = true;
+        return;
+    }
+
+    bLedgerSyncing = true;
+    bLedgerSyncPending = false;
+    RequestLedgerBlocks(LedgerMirror->Num() == 0);
+}
+
+void UInterverseChainComponent::RequestLedgerBlocks(bool bFullDownload)
+{
+    const FString Path = bFullDownload
+        ? FString(TEXT("chain"))
+        : FString::Printf(TEXT("chain?from=%lld"), LedgerMirror->GetHeight() + 1);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("GET"), Path);
+
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    Request->OnProcessRequestComplete().BindLambda([WeakThis, bFullDownload](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+    {
+        if (!bSuccess || !Response.IsValid())
+        {
+            if (UInterverseChainComponent* This = WeakThis.Get())
+            {
+                This->OnLedgerBlocksDecoded(bFullDownload, false, TArray<FInterverseLedgerBlock>());
             }
+            return;
         }
-        else if (MessageType == "balance_update")
+
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Response, bFullDownload]()
         {
-            const TSharedPtr<FJsonObject>* DataObject;
-            if (JsonObject->TryGetObjectField("data", DataObject))
+            TArray<FInterverseLedgerBlock> Blocks;
+            bool bParsed = false;
             {
-                const float NewBalance = (*DataObject)->GetNumberField("balance");
-                AsyncTask(ENamedThreads::GameThread, [this, NewBalance]() {
-                    OnBalanceUpdated.Broadcast(NewBalance);
-                });
+                SCOPE_CYCLE_COUNTER(STAT_InterverseDecodePayload);
+                bParsed = FInterverseLedgerMirror::DecodeBlocks(Response->GetContentAsString(), Blocks);
             }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, bFullDownload, bParsed, Blocks = MoveTemp(Blocks)]() mutable
+            {
+                if (UInterverseChainComponent* This = WeakThis.Get())
+                {
+                    This->OnLedgerBlocksDecoded(bFullDownload, bParsed, MoveTemp(Blocks));
+                }
+            });
+        });
+    });
+
+    SubmitChainRequest(Request, EInterverseRequestPriority::Low);
+}
+
+void UInterverseChainComponent::OnLedgerBlocksDecoded(bool bFullDownload, bool bParsed, TArray<FInterverseLedgerBlock>&& Blocks)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseApplyPayload);
+
+    if (!bParsed)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to fetch ledger blocks from %s"), *NodeUrl);
+        bLedgerSyncing = false;
+        return;
+    }
+
+    if (bFullDownload)
+    {
+        LedgerMirror->Reset();
+    }
+
+    const int32 NewBlocks = LedgerMirror->ApplyBlocks(MoveTemp(Blocks));
+    if (NewBlocks == INDEX_NONE)
+    {
+        if (!bFullDownload)
+        {
+            // Our tip is no longer on the node's chain, or blocks are missing; start over
+            UE_LOG(LogTemp, Warning, TEXT("Ledger mirror diverged from %s at height %lld, downloading the full chain"), *NodeUrl, LedgerMirror->GetHeight());
+            RequestLedgerBlocks(true);
+            return;
         }
-        else if (MessageType == "transfer_complete")
+
+        UE_LOG(LogTemp, Error, TEXT("Ledger from %s does not chain by hash; keeping the verified prefix up to %lld"), *NodeUrl, LedgerMirror->GetHeight());
+    }
+
+    bLedgerSyncing = false;
+
+    if (NewBlocks > 0 && bPersistLedgerMirror)
+    {
+        SaveLedgerMirror();
+    }
+
+    OnLedgerSynced.Broadcast(LedgerMirror->GetHeight(), FMath::Max(NewBlocks, 0));
+
+    if (bLedgerSyncPending)
+    {
+        SyncLedger();
+    }
+}
+
+int64 UInterverseChainComponent::GetLedgerHeight() const
+{
+    return LedgerMirror->GetHeight();
+}
+
+FString UInterverseChainComponent::GetLedgerLatestHash() const
+{
+    return LedgerMirror->GetLatestHash();
+}
+
+bool UInterverseChainComponent::GetLedgerBlock(int64 Index, FInterverseLedgerBlock& OutBlock) const
+{
+    if (const FInterverseLedgerBlock* Block = LedgerMirror->FindBlock(Index))
+    {
+        OutBlock = *Block;
+        return true;
+    }
+    return false;
+}
+
+void UInterverseChainComponent::GetLedgerBlocksSince(int64 Index, int32 MaxBlocks, TArray<FInterverseLedgerBlock>& OutBlocks) const
+{
+    LedgerMirror->GetBlocksSince(Index, MaxBlocks, OutBlocks);
+}
+
+FString UInterverseChainComponent::GetLedgerMirrorPath() const
+{
+    // One file per node so switching NodeUrl never mixes chains
+    return FPaths::ProjectSavedDir() / TEXT("Interverse") / FString::Printf(TEXT("Ledger_%s.bin"), *FMD5::HashAnsiString(*NodeUrl));
+}
+
+void UInterverseChainComponent::LoadLedgerMirror()
+{
+    if (bLedgerLoading || NodeUrl.IsEmpty())
+    {
+        return;
+    }
+
+    bLedgerLoading = true;
+
+    // Reading and verifying a large mirror stays off the game thread
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    const FString Path = GetLedgerMirrorPath();
+    LedgerFilePipe.Launch(UE_SOURCE_LOCATION, [WeakThis, Path]()
+    {
+        TSharedPtr<FInterverseLedgerMirror> Loaded;
+        TArray<uint8> Bytes;
+        if (FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
         {
-            const TSharedPtr<FJsonObject>* DataObject;
-            if (JsonObject->TryGetObjectField("data", DataObject))
+            Loaded = MakeShared<FInterverseLedgerMirror>();
+            if (!Loaded->LoadFromBytes(Bytes))
             {
-                const FString AssetId = (*DataObject)->GetStringField("asset_id");
-                const bool Success = (*DataObject)->GetBoolField("success");
-                AsyncTask(ENamedThreads::GameThread, [this, AssetId, Success]() {
-                     OnTransferComplete.Broadcast(AssetId, TEXT(""), Success);
-                });
+                UE_LOG(LogTemp, Warning, TEXT("Ignoring unreadable ledger mirror %s"), *Path);
+                Loaded.Reset();
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Loaded]()
+        {
+            UInterverseChainComponent* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            This->bLedgerLoading = false;
+
+            // A sync that finished while we were loading is at least as fresh
+            if (Loaded.IsValid() && This->LedgerMirror->Num() == 0)
+            {
+                This->LedgerMirror = Loaded;
+                UE_LOG(LogTemp, Log, TEXT("Loaded ledger mirror at height %lld"), Loaded->GetHeight());
+            }
+
+            if (This->bLedgerSyncPending)
+            {
+                This->SyncLedger();
             }
+        });
+    });
+}
+
+void UInterverseChainComponent::SaveLedgerMirror()
+{
+    if (NodeUrl.IsEmpty())
+    {
+        return;
+    }
+
+    TSharedRef<TArray<uint8>> Bytes = MakeShared<TArray<uint8>>();
+    LedgerMirror->SaveToBytes(*Bytes);
+
+    // Written beside the real file and moved over it, so a crash mid-write leaves the old mirror intact
+    const FString Path = GetLedgerMirrorPath();
+    LedgerFilePipe.Launch(UE_SOURCE_LOCATION, [Bytes, Path]()
+    {
+        const FString TempPath = Path + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(*Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to save ledger mirror to %s"), *Path);
+            IFileManager::Get().Delete(*TempPath, false, false, true);
         }
+    });
+}
+
+void UInterverseChainComponent::GetTransactionHistory(const FString& Address, TArray<FString>& OutTransactions)
+{
+    // Answer from what we already have; the request can't write into OutTransactions later
+    // because the caller's array may be gone by the time the node replies
+    if (const FTransactionHistoryMirror* Mirror = HistoryMirrors.Find(Address))
+    {
+        OutTransactions = Mirror->Transactions;
     }
+
+    SyncTransactionHistory(Address);
 }
 
-void UInterverseChainComponent::RecordTransaction(const FString& TransactionData)
+void UInterverseChainComponent::GetTransactionHistoryPage(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence, const FOnTransactionPageReceived& OnPage)
+{
+    GetTransactionHistoryPage(Address, Cursor, PageSize, SinceSequence, [OnPage](bool bSuccess, const FInterverseTransactionPage& Page)
+    {
+        OnPage.ExecuteIfBound(bSuccess, Page);
+    });
+}
+
+void UInterverseChainComponent::GetTransactionHistoryPage(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence, FOnTransactionPageQueried OnPage)
 {
-    if (!TransactionData.IsEmpty())
+    if (Address.IsEmpty()) return;
+
+    PageSize = FMath::Max(1, PageSize);
+
+    // A page fetched ahead of time is handed over without touching the network
+    const FString PrefetchKey = MakeHistoryPageKey(Address, Cursor, PageSize, SinceSequence);
+    FInterverseTransactionPage Prefetched;
+    if (PrefetchedHistoryPages.RemoveAndCopyValue(PrefetchKey, Prefetched))
     {
-        // Send transaction data to blockchain
-        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-        Request->OnProcessRequestComplete().BindUObject(this, &UInterverseChainComponent::OnHttpResponseReceived);
-        
-        FString Endpoint = InterverseCompat::GetEndpointPath(TEXT("transactions/record"));
-        Request->SetURL(FString::Printf(TEXT("%s/%s"), *NodeUrl, *Endpoint));
-        Request->SetVerb(TEXT("POST"));
-        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-        Request->SetHeader(TEXT("X-API-Key"), ApiKey);
-        Request->SetContentAsString(TransactionData);
-        Request->ProcessRequest();
+        PrefetchedHistoryOrder.RemoveSingle(PrefetchKey);
+        PrefetchHistoryPage(Address, Prefetched, PageSize, SinceSequence);
+        if (OnPage)
+        {
+            OnPage(true, Prefetched);
+        }
+        return;
     }
+
+    RequestHistoryPage(Address, Cursor, PageSize, SinceSequence, MoveTemp(OnPage));
 }
 
-void UInterverseChainComponent::GetLedgerState(FString& OutLedgerState)
+void UInterverseChainComponent::RequestHistoryPage(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence, FOnTransactionPageQueried OnPage)
 {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindLambda([&OutLedgerState](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+    const FString Key = MakeHistoryPageKey(Address, Cursor, PageSize, SinceSequence);
+
+    // Join a request that is already on its way, including a prefetch
+    if (TArray<FOnTransactionPageQueried>* Waiters = InFlightHistoryPages.Find(Key))
+    {
+        if (OnPage)
+        {
+            Waiters->Add(MoveTemp(OnPage));
+        }
+        return;
+    }
+
+    // Prefetches have no waiter and go out behind everything player-facing
+    const bool bIsPrefetch = !OnPage;
+    TArray<FOnTransactionPageQueried>& Waiters = InFlightHistoryPages.Add(Key);
+    if (OnPage)
     {
-        if (bSuccess && Response.IsValid())
+        Waiters.Add(MoveTemp(OnPage));
+    }
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("GET"), MakeHistoryPagePath(Address, Cursor, PageSize, SinceSequence));
+
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    Request->OnProcessRequestComplete().BindLambda([WeakThis, Key, Address, PageSize, SinceSequence](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+    {
+        if (!bSuccess || !Response.IsValid())
         {
-            OutLedgerState = Response->GetContentAsString();
+            if (UInterverseChainComponent* This = WeakThis.Get())
+            {
+                This->CompleteHistoryPage(Key, Address, PageSize, SinceSequence, false, FInterverseTransactionPage());
+            }
+            return;
         }
+
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Response, Key, Address, PageSize, SinceSequence]()
+        {
+            FInterverseTransactionPage Page;
+            bool bParsed = false;
+            {
+                SCOPE_CYCLE_COUNTER(STAT_InterverseDecodePayload);
+                bParsed = DecodeTransactionPage(Response->GetContentAsString(), Page);
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Key, Address, PageSize, SinceSequence, bParsed, Page = MoveTemp(Page)]()
+            {
+                if (UInterverseChainComponent* This = WeakThis.Get())
+                {
+                    This->CompleteHistoryPage(Key, Address, PageSize, SinceSequence, bParsed, Page);
+                }
+            });
+        });
     });
-    
-    Request->SetURL(FString::Printf(TEXT("%s/chain"), *NodeUrl));
-    Request->SetVerb(TEXT("GET"));
-    Request->SetHeader(TEXT("X-API-Key"), ApiKey);
-    Request->ProcessRequest();
+
+    SubmitChainRequest(Request, bIsPrefetch ? EInterverseRequestPriority::Low : EInterverseRequestPriority::Normal);
 }
 
-void UInterverseChainComponent::GetTransactionHistory(const FString& Address, TArray<FString>& OutTransactions)
+void UInterverseChainComponent::CompleteHistoryPage(const FString& Key, const FString& Address, int32 PageSize, int64 SinceSequence, bool bParsed, const FInterverseTransactionPage& Page)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseApplyPayload);
+
+    TArray<FOnTransactionPageQueried> Waiters;
+    InFlightHistoryPages.RemoveAndCopyValue(Key, Waiters);
+
+    if (!bParsed)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to fetch transaction history page for %s"), *Address);
+    }
+
+    if (Waiters.Num() == 0)
+    {
+        // Nobody has asked for this page yet; hold it until they do
+        if (bParsed)
+        {
+            // Evict the oldest page only, so a reader partway through another wallet keeps its next page
+            constexpr int32 MaxPrefetchedHistoryPages = 16;
+            if (!PrefetchedHistoryPages.Contains(Key))
+            {
+                while (PrefetchedHistoryPages.Num() >= MaxPrefetchedHistoryPages && PrefetchedHistoryOrder.Num() > 0)
+                {
+                    PrefetchedHistoryPages.Remove(PrefetchedHistoryOrder[0]);
+                    PrefetchedHistoryOrder.RemoveAt(0, 1, EAllowShrinking::No);
+                }
+                PrefetchedHistoryOrder.Add(Key);
+            }
+            PrefetchedHistoryPages.Add(Key, Page);
+        }
+        return;
+    }
+
+    if (bParsed)
+    {
+        PrefetchHistoryPage(Address, Page, PageSize, SinceSequence);
+    }
+
+    for (FOnTransactionPageQueried& Waiter : Waiters)
+    {
+        Waiter(bParsed, Page);
+    }
+}
+
+void UInterverseChainComponent::PrefetchHistoryPage(const FString& Address, const FInterverseTransactionPage& Page, int32 PageSize, int64 SinceSequence)
+{
+    if (!bPrefetchHistoryPages || !Page.bHasMore)
+    {
+        return;
+    }
+
+    const FString Key = MakeHistoryPageKey(Address, Page.NextCursor, PageSize, SinceSequence);
+    if (PrefetchedHistoryPages.Contains(Key) || InFlightHistoryPages.Contains(Key))
+    {
+        return;
+    }
+
+    RequestHistoryPage(Address, Page.NextCursor, PageSize, SinceSequence, FOnTransactionPageQueried());
+}
+
+void UInterverseChainComponent::SyncTransactionHistory(const FString& Address)
+{
+    if (Address.IsEmpty()) return;
+
+    FTransactionHistoryMirror& Mirror = HistoryMirrors.FindOrAdd(Address);
+    if (Mirror.bSyncing)
+    {
+        return;
+    }
+
+    Mirror.bSyncing = true;
+    SyncHistoryStep(Address, FString(), Mirror.LatestSequence, MakeShared<TArray<FString>>());
+}
+
+void UInterverseChainComponent::SyncHistoryStep(const FString& Address, const FString& Cursor, int64 SinceSequence, TSharedRef<TArray<FString>> NewTransactions)
 {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindLambda([&OutTransactions](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+    // Waiters are owned and run by this component, so capturing this is safe
+    GetTransactionHistoryPage(Address, Cursor, HistoryPageSize, SinceSequence, [this, Address, SinceSequence, NewTransactions](bool bSuccess, const FInterverseTransactionPage& Page)
     {
-        if (bSuccess && Response.IsValid())
+        if (bSuccess)
+        {
+            NewTransactions->Append(Page.Transactions);
+            if (Page.bHasMore)
+            {
+                SyncHistoryStep(Address, Page.NextCursor, SinceSequence, NewTransactions);
+                return;
+            }
+        }
+
+        FTransactionHistoryMirror& Mirror = HistoryMirrors.FindOrAdd(Address);
+        Mirror.bSyncing = false;
+
+        // Only a complete run is committed, so a failed sync retries from the same point
+        if (!bSuccess)
+        {
+            return;
+        }
+
+        if (SinceSequence < 0)
         {
-            TSharedPtr<FJsonObject> JsonObject;
-            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-            
-            if (FJsonSerializer::Deserialize(Reader, JsonObject))
+            // Full download: report what the mirror did not have and replace it
+            TSet<FString> Known(Mirror.Transactions);
+            TArray<FString> Added;
+            for (const FString& Transaction : *NewTransactions)
             {
-                const TArray<TSharedPtr<FJsonValue>>* TransactionsArray;
-                if (JsonObject->TryGetArrayField(TEXT("transactions"), TransactionsArray))
+                if (!Known.Contains(Transaction))
                 {
-                    for (const auto& TransactionValue : *TransactionsArray)
-                    {
-                        FString TransactionString;
-                        if (TransactionValue->TryGetString(TransactionString))
-                        {
-                            OutTransactions.Add(TransactionString);
-                        }
-                    }
+                    Added.Add(Transaction);
                 }
             }
+            Mirror.Transactions = MoveTemp(*NewTransactions);
+            *NewTransactions = MoveTemp(Added);
+        }
+        else
+        {
+            Mirror.Transactions.Append(*NewTransactions);
+        }
+
+        Mirror.LatestSequence = FMath::Max(Mirror.LatestSequence, Page.LatestSequence);
+
+        if (NewTransactions->Num() > 0)
+        {
+            OnTransactionHistorySynced.Broadcast(Address, *NewTransactions);
         }
     });
-    
-    Request->SetURL(FString::Printf(TEXT("%s/transactions/%s"), *NodeUrl, *Address));
-    Request->SetVerb(TEXT("GET"));
-    Request->SetHeader(TEXT("X-API-Key"), ApiKey);
-    Request->ProcessRequest();
+}
+
+void UInterverseChainComponent::StreamTransactionHistory(const FString& Address, int32 ChunkSize, FOnTransactionChunk OnChunk, FOnListStreamComplete OnComplete)
+{
+    if (Address.IsEmpty()) return;
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateChainRequest(TEXT("GET"), FString::Printf(TEXT("transactions/%s"), *Address));
+
+    TWeakObjectPtr<UInterverseChainComponent> WeakThis(this);
+    TSharedRef<FOnTransactionChunk> SharedOnChunk = MakeShared<FOnTransactionChunk>(MoveTemp(OnChunk));
+    Request->OnProcessRequestComplete().BindLambda([WeakThis, SharedOnChunk, ChunkSize, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+    {
+        StreamListResponse<FString>(WeakThis, Response, bSuccess, SharedOnChunk, OnComplete,
+            [ChunkSize](const FString& Content, TFunctionRef<void(TArray<FString>&&)> Emit)
+            {
+                return FInterverseJsonListReader::ReadTransactions(Content, ChunkSize, Emit);
+            });
+    });
+
+    SubmitChainRequest(Request, EInterverseRequestPriority::Low);
 }
 
 void UInterverseChainComponent::SendWebSocketMessage(const FString& Message)
 {
-    if (WebSocket.IsValid() && WebSocket->IsConnected())
+    if (!SocketConnection.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot send message - WebSocket not initialized"));
+        return;
+    }
+
+    if (SocketConnection->Send(Message))
     {
-        UE_LOG(LogTemp, Verbose, TEXT("Sending WebSocket message: %s"), *Message);
-        WebSocket->Send(Message);
+        UE_LOG(LogTemp, Verbose, TEXT("Queued WebSocket message: %s"), *Message);
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("Cannot send message - WebSocket not connected"));
+        UE_LOG(LogTemp, Warning, TEXT("Cannot send message - outbound WebSocket queue is full"));
+    }
+}
+
+void UInterverseChainComponent::SendWebSocketMessage(const TSharedRef<FJsonObject>& Message)
+{
+    if (!SocketConnection.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot send message - WebSocket not initialized"));
+        return;
+    }
+
+    if (!SocketConnection->Send(Message))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot send message - outbound WebSocket queue is full"));
     }
 }
 
+EInterverseWireFormat UInterverseChainComponent::GetWireFormat() const
+{
+    return SocketConnection.IsValid() ? SocketConnection->GetNegotiatedFormat() : EInterverseWireFormat::Json;
+}
+
+EInterverseWireFormat UInterverseChainComponent::GetHttpWireFormat() const
+{
+    return SocketConnection.IsValid() ? SocketConnection->GetHttpFormat() : EInterverseWireFormat::Json;
+}
+
 bool UInterverseChainComponent::IsWebSocketConnected() const
 {
-    return WebSocket.IsValid() && WebSocket->IsConnected();
+    return SocketConnection.IsValid() && SocketConnection->IsConnected();
 }
 
 void UInterverseChainComponent::ReconnectWebSocket()
 {
-    UE_LOG(LogTemp, Log, TEXT("Attempting to reconnect WebSocket"));
-    DisconnectWebSocket();
-    ConnectWebSocket();
+    if (SocketConnection.IsValid())
+    {
+        SocketConnection->Reconnect();
+    }
+    else
+    {
+        ConnectWebSocket();
+    }
+}
+
+void UInterverseChainComponent::SubscribeToAddress(const FString& Address)
+{
+    SubscribedAddresses.Add(Address);
+
+    if (SocketConnection.IsValid())
+    {
+        SocketConnection->AddSubscriberAddress(SocketSubscriberHandle, Address);
+    }
+}
+
+void UInterverseChainComponent::UnsubscribeFromAddress(const FString& Address)
+{
+    SubscribedAddresses.Remove(Address);
+
+    if (SocketConnection.IsValid())
+    {
+        SocketConnection->RemoveSubscriberAddress(SocketSubscriberHandle, Address);
+    }
+}
+
+void UInterverseChainComponent::SubscribeToAsset(const FString& AssetId)
+{
+    SubscribedAssetIds.Add(AssetId);
+
+    if (SocketConnection.IsValid())
+    {
+        SocketConnection->AddSubscriberAsset(SocketSubscriberHandle, AssetId);
+    }
+}
+
+void UInterverseChainComponent::UnsubscribeFromAsset(const FString& AssetId)
+{
+    SubscribedAssetIds.Remove(AssetId);
+
+    if (SocketConnection.IsValid())
+    {
+        SocketConnection->RemoveSubscriberAsset(SocketSubscriberHandle, AssetId);
+    }
+}
+
+FInterverseSocketStats UInterverseChainComponent::GetSocketStats() const
+{
+    return FInterverseConnectionManager::Get().GetStats();
 }
 
 FString UInterverseChainComponent::GetConnectionStatus() const
 {
-    if (!WebSocket.IsValid())
+    if (!SocketConnection.IsValid() || !SocketConnection->IsCreated())
     {
         return TEXT("Not Initialized");
     }
-    else if (WebSocket->IsConnected())
+    else if (SocketConnection->IsConnected())
     {
         return TEXT("Connected");
     }
@@ -493,4 +1775,4 @@ FString UInterverseChainComponent::GetConnectionStatus() const
     {
         return TEXT("Disconnected");
     }
-}
\ No newline at end of file
+}
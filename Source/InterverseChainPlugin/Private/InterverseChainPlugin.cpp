@@ -1,13 +1,18 @@
 #include "INTERVERSEChainPlugin.h"
+#include "InterverseConnectionManager.h"
+#include "InterverseSerializationPlan.h"
 
 #define LOCTEXT_NAMESPACE "FVERSEChainPluginModule"
 
 void FINTERVERSEChainPluginModule::StartupModule()
 {
+    FInterverseSerializationPlan::RegisterInvalidationHooks();
 }
 
 void FINTERVERSEChainPluginModule::ShutdownModule()
 {
+    FInterverseConnectionManager::Get().Shutdown();
+    FInterverseSerializationPlan::UnregisterInvalidationHooks();
 }
 
 #undef LOCTEXT_NAMESPACE
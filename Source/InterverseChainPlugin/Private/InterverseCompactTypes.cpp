@@ -0,0 +1,255 @@
+#include "InterverseCompactTypes.h"
+
+namespace
+{
+    template<typename ValueType>
+    const ValueType* FindEntry(const TArray<TPair<int32, ValueType>>& Entries, int32 Symbol)
+    {
+        // Bags hold a handful of keys, so a linear scan over ints beats hashing
+        for (const TPair<int32, ValueType>& Entry : Entries)
+        {
+            if (Entry.Key == Symbol)
+            {
+                return &Entry.Value;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename ValueType>
+    void InternMap(const TMap<FString, ValueType>& Source, TArray<TPair<int32, ValueType>>& OutEntries)
+    {
+        FInterversePropertyKeyTable& Keys = FInterversePropertyKeyTable::Get();
+        OutEntries.Reserve(Source.Num());
+        for (const TPair<FString, ValueType>& Pair : Source)
+        {
+            OutEntries.Emplace(Keys.Intern(Pair.Key), Pair.Value);
+        }
+    }
+
+    template<typename ValueType>
+    void ExpandMap(const TArray<TPair<int32, ValueType>>& Entries, TMap<FString, ValueType>& OutMap)
+    {
+        const FInterversePropertyKeyTable& Keys = FInterversePropertyKeyTable::Get();
+        OutMap.Reserve(Entries.Num());
+        for (const TPair<int32, ValueType>& Entry : Entries)
+        {
+            OutMap.Add(Keys.Resolve(Entry.Key), Entry.Value);
+        }
+    }
+
+    SIZE_T GetStringsAllocatedSize(const TArray<TPair<int32, FString>>& Entries)
+    {
+        SIZE_T Size = Entries.GetAllocatedSize();
+        for (const TPair<int32, FString>& Entry : Entries)
+        {
+            Size += Entry.Value.GetAllocatedSize();
+        }
+        return Size;
+    }
+
+    SIZE_T GetStringMapAllocatedSize(const TMap<FString, FString>& Map)
+    {
+        SIZE_T Size = Map.GetAllocatedSize();
+        for (const TPair<FString, FString>& Pair : Map)
+        {
+            Size += Pair.Key.GetAllocatedSize() + Pair.Value.GetAllocatedSize();
+        }
+        return Size;
+    }
+}
+
+FInterversePropertyKeyTable& FInterversePropertyKeyTable::Get()
+{
+    static FInterversePropertyKeyTable Table;
+    return Table;
+}
+
+int32 FInterversePropertyKeyTable::Intern(const FString& Key)
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const int32* Symbol = SymbolsByKey.Find(Key))
+        {
+            return *Symbol;
+        }
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    if (const int32* Symbol = SymbolsByKey.Find(Key))
+    {
+        return *Symbol;
+    }
+
+    const int32 Symbol = KeysBySymbol.Add(MakeUnique<FString>(Key));
+    SymbolsByKey.Add(Key, Symbol);
+    return Symbol;
+}
+
+int32 FInterversePropertyKeyTable::Find(const FString& Key) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const int32* Symbol = SymbolsByKey.Find(Key);
+    return Symbol ? *Symbol : INDEX_NONE;
+}
+
+const FString& FInterversePropertyKeyTable::Resolve(int32 Symbol) const
+{
+    FReadScopeLock ReadLock(Lock);
+    check(KeysBySymbol.IsValidIndex(Symbol));
+    return *KeysBySymbol[Symbol];
+}
+
+int32 FInterversePropertyKeyTable::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return KeysBySymbol.Num();
+}
+
+FInterverseCompactProperties FInterverseCompactProperties::FromProperties(const FInterverseBaseProperties& Properties)
+{
+    FInterverseCompactProperties Compact;
+    Compact.Category = Properties.Category;
+    Compact.Rarity = Properties.Rarity;
+    Compact.Level = Properties.Level;
+    Compact.ModelIdentifier = Properties.ModelIdentifier;
+    Compact.PrimaryColor = Properties.PrimaryColor;
+    Compact.SecondaryColor = Properties.SecondaryColor;
+    InternMap(Properties.NumericProperties, Compact.NumericProperties);
+    InternMap(Properties.StringProperties, Compact.StringProperties);
+    Compact.Tags = Properties.Tags;
+    Compact.OwnerGlobalID = Properties.OwnerGlobalID;
+    Compact.TargetPlayerID = Properties.TargetPlayerID;
+    return Compact;
+}
+
+FInterverseBaseProperties FInterverseCompactProperties::ToProperties() const
+{
+    FInterverseBaseProperties Properties;
+    Properties.Category = Category;
+    Properties.Rarity = Rarity;
+    Properties.Level = Level;
+    Properties.ModelIdentifier = ModelIdentifier;
+    Properties.PrimaryColor = PrimaryColor;
+    Properties.SecondaryColor = SecondaryColor;
+    ExpandMap(NumericProperties, Properties.NumericProperties);
+    ExpandMap(StringProperties, Properties.StringProperties);
+    Properties.Tags = Tags;
+    Properties.OwnerGlobalID = OwnerGlobalID;
+    Properties.TargetPlayerID = TargetPlayerID;
+    return Properties;
+}
+
+const float* FInterverseCompactProperties::FindNumeric(int32 Symbol) const
+{
+    return FindEntry(NumericProperties, Symbol);
+}
+
+const float* FInterverseCompactProperties::FindNumeric(const FString& Key) const
+{
+    const int32 Symbol = FInterversePropertyKeyTable::Get().Find(Key);
+    return Symbol != INDEX_NONE ? FindNumeric(Symbol) : nullptr;
+}
+
+const FString* FInterverseCompactProperties::FindString(int32 Symbol) const
+{
+    return FindEntry(StringProperties, Symbol);
+}
+
+const FString* FInterverseCompactProperties::FindString(const FString& Key) const
+{
+    const int32 Symbol = FInterversePropertyKeyTable::Get().Find(Key);
+    return Symbol != INDEX_NONE ? FindString(Symbol) : nullptr;
+}
+
+SIZE_T FInterverseCompactProperties::GetAllocatedSize() const
+{
+    SIZE_T Size = ModelIdentifier.GetAllocatedSize()
+        + NumericProperties.GetAllocatedSize()
+        + GetStringsAllocatedSize(StringProperties)
+        + Tags.GetAllocatedSize()
+        + OwnerGlobalID.GetAllocatedSize()
+        + TargetPlayerID.GetAllocatedSize();
+
+    for (const FString& Tag : Tags)
+    {
+        Size += Tag.GetAllocatedSize();
+    }
+    return Size;
+}
+
+FInterverseCompactAsset FInterverseCompactAsset::FromAsset(const FInterverseAsset& Asset)
+{
+    FInterverseCompactAsset Compact;
+    Compact.AssetId = Asset.AssetId;
+    Compact.Owner = Asset.Owner;
+    Compact.OwnerGlobalID = Asset.OwnerGlobalID;
+    Compact.AssetType = Asset.AssetType;
+    Compact.Category = Asset.Category;
+    Compact.Rarity = Asset.Rarity;
+    InternMap(Asset.Metadata, Compact.Metadata);
+    return Compact;
+}
+
+FInterverseAsset FInterverseCompactAsset::ToAsset() const
+{
+    FInterverseAsset Asset;
+    Asset.AssetId = AssetId;
+    Asset.Owner = Owner;
+    Asset.OwnerGlobalID = OwnerGlobalID;
+    Asset.AssetType = AssetType;
+    Asset.Category = Category;
+    Asset.Rarity = Rarity;
+    ExpandMap(Metadata, Asset.Metadata);
+    return Asset;
+}
+
+const FString* FInterverseCompactAsset::FindMetadata(int32 Symbol) const
+{
+    return FindEntry(Metadata, Symbol);
+}
+
+const FString* FInterverseCompactAsset::FindMetadata(const FString& Key) const
+{
+    const int32 Symbol = FInterversePropertyKeyTable::Get().Find(Key);
+    return Symbol != INDEX_NONE ? FindMetadata(Symbol) : nullptr;
+}
+
+SIZE_T FInterverseCompactAsset::GetAllocatedSize() const
+{
+    return AssetId.GetAllocatedSize()
+        + Owner.GetAllocatedSize()
+        + OwnerGlobalID.GetAllocatedSize()
+        + GetStringsAllocatedSize(Metadata);
+}
+
+namespace InterverseCompact
+{
+    SIZE_T GetAllocatedSize(const FInterverseBaseProperties& Properties)
+    {
+        SIZE_T Size = Properties.ModelIdentifier.GetAllocatedSize()
+            + Properties.NumericProperties.GetAllocatedSize()
+            + GetStringMapAllocatedSize(Properties.StringProperties)
+            + Properties.Tags.GetAllocatedSize()
+            + Properties.OwnerGlobalID.GetAllocatedSize()
+            + Properties.TargetPlayerID.GetAllocatedSize();
+
+        for (const TPair<FString, float>& Pair : Properties.NumericProperties)
+        {
+            Size += Pair.Key.GetAllocatedSize();
+        }
+        for (const FString& Tag : Properties.Tags)
+        {
+            Size += Tag.GetAllocatedSize();
+        }
+        return Size;
+    }
+
+    SIZE_T GetAllocatedSize(const FInterverseAsset& Asset)
+    {
+        return Asset.AssetId.GetAllocatedSize()
+            + Asset.Owner.GetAllocatedSize()
+            + Asset.OwnerGlobalID.GetAllocatedSize()
+            + GetStringMapAllocatedSize(Asset.Metadata);
+    }
+}
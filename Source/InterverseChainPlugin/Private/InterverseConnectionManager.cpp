@@ -0,0 +1,1146 @@
+#include "InterverseConnectionManager.h"
+#include "InterverseMessageRegistry.h"
+#include "InterverseStats.h"
+#include "WebSocketsModule.h"
+#include "Json.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+DECLARE_CYCLE_STAT(TEXT("Decode WebSocket Message (Worker)"), STAT_InterverseDecodeSocketMessage, STATGROUP_Interverse);
+DECLARE_CYCLE_STAT(TEXT("Route WebSocket Message"), STAT_InterverseRouteSocketMessage, STATGROUP_Interverse);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("WebSocket Messages Awaiting Route"), STAT_InterversePendingMessages, STATGROUP_Interverse);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WebSocket Messages Routed"), STAT_InterverseMessagesRouted, STATGROUP_Interverse);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("WebSocket Messages Awaiting Send"), STAT_InterverseOutboundQueued, STATGROUP_Interverse);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WebSocket Frames Sent"), STAT_InterverseFramesSent, STATGROUP_Interverse);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WebSocket Binary Frames Sent"), STAT_InterverseBinaryFramesSent, STATGROUP_Interverse);
+
+FInterverseSocketConnection::FInterverseSocketConnection(
+    const FString& InNodeUrl,
+    const FString& InApiKey,
+    const FString& InGameId,
+    float InReconnectDelay,
+    float InMaxReconnectDelay,
+    const FInterverseSendQueueSettings& InSendSettings,
+    EInterverseWireFormat InPreferredFormat)
+    : NodeUrl(InNodeUrl)
+    , ApiKey(InApiKey)
+    , GameId(InGameId)
+    , ReconnectDelay(InReconnectDelay)
+    , MaxReconnectDelay(FMath::Max(InReconnectDelay, InMaxReconnectDelay))
+    , PreferredFormat(InPreferredFormat)
+    , SendSettings(InSendSettings)
+{
+}
+
+FInterverseSocketConnection::~FInterverseSocketConnection()
+{
+    CancelReconnect();
+    ClearOutbound();
+}
+
+int32 FInterverseSocketConnection::AddSubscriber(FInterverseSocketSubscriber&& Subscriber)
+{
+    const int32 Handle = NextSubscriberHandle++;
+    Subscribers.Add(Handle, MoveTemp(Subscriber));
+    SyncRemoteTopics();
+    return Handle;
+}
+
+void FInterverseSocketConnection::RemoveSubscriber(int32 Handle)
+{
+    if (Subscribers.Remove(Handle) > 0)
+    {
+        SyncRemoteTopics();
+    }
+}
+
+void FInterverseSocketConnection::AddSubscriberAddress(int32 Handle, const FString& Address)
+{
+    if (FInterverseSocketSubscriber* Subscriber = Subscribers.Find(Handle))
+    {
+        Subscriber->Addresses.Add(Address);
+        SyncRemoteTopics();
+    }
+}
+
+void FInterverseSocketConnection::RemoveSubscriberAddress(int32 Handle, const FString& Address)
+{
+    if (FInterverseSocketSubscriber* Subscriber = Subscribers.Find(Handle))
+    {
+        Subscriber->Addresses.Remove(Address);
+        SyncRemoteTopics();
+    }
+}
+
+void FInterverseSocketConnection::AddSubscriberAsset(int32 Handle, const FString& AssetId)
+{
+    if (FInterverseSocketSubscriber* Subscriber = Subscribers.Find(Handle))
+    {
+        Subscriber->AssetIds.Add(AssetId);
+        SyncRemoteTopics();
+    }
+}
+
+void FInterverseSocketConnection::RemoveSubscriberAsset(int32 Handle, const FString& AssetId)
+{
+    if (FInterverseSocketSubscriber* Subscriber = Subscribers.Find(Handle))
+    {
+        Subscriber->AssetIds.Remove(AssetId);
+        SyncRemoteTopics();
+    }
+}
+
+void FInterverseSocketConnection::Connect()
+{
+    if (WebSocket.IsValid())
+    {
+        // Already connected or connecting; late subscribers still want to know
+        if (WebSocket->IsConnected())
+        {
+            NotifyConnected(true);
+        }
+        return;
+    }
+
+    // Load WebSocket module for UE5
+    const FName WebSocketModuleName = TEXT("WebSockets");
+    if (!FModuleManager::Get().IsModuleLoaded(WebSocketModuleName))
+    {
+        FModuleManager::Get().LoadModule(WebSocketModuleName);
+        if (!FModuleManager::Get().IsModuleLoaded(WebSocketModuleName))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to load WebSockets module"));
+            return;
+        }
+    }
+
+    // Construct WebSocket URL for UE5
+    FString WsUrl = NodeUrl;
+    WsUrl.ReplaceInline(TEXT("http://"), TEXT("ws://"));
+    WsUrl.ReplaceInline(TEXT("https://"), TEXT("wss://"));
+    
+    // Remove any trailing slashes for UE5
+    while (WsUrl.EndsWith(TEXT("/")))
+    {
+        WsUrl.LeftChopInline(1);
+    }
+    
+    // Add /ws endpoint and API key
+    WsUrl = FString::Printf(TEXT("%s/ws?api_key=%s"), *WsUrl, *ApiKey);
+    
+    UE_LOG(LogTemp, Log, TEXT("UE5 Connecting to WebSocket URL: %s"), *WsUrl);
+
+    // UE5 specific headers
+    TMap<FString, FString> Headers;
+    Headers.Add(TEXT("Sec-WebSocket-Protocol"), TEXT("verse-protocol"));
+    Headers.Add(TEXT("Upgrade"), TEXT("websocket"));
+    Headers.Add(TEXT("Connection"), TEXT("Upgrade"));
+    Headers.Add(TEXT("Sec-WebSocket-Version"), TEXT("13"));
+
+    // Create WebSocket with UE5's implementation
+    WebSocket = SocketFactory
+        ? SocketFactory(WsUrl, TEXT("verse-protocol"), Headers)
+        : FWebSocketsModule::Get().CreateWebSocket(WsUrl, TEXT("verse-protocol"), Headers);
+    
+    if (!WebSocket.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to create WebSocket in UE5"));
+        return;
+    }
+
+    bClosing = false;
+    BindSocketHandlers();
+
+    UE_LOG(LogTemp, Log, TEXT("UE5 Initiating WebSocket connection"));
+    WebSocket->Connect();
+}
+
+void FInterverseSocketConnection::BindSocketHandlers()
+{
+    TWeakPtr<FInterverseSocketConnection> WeakThis = AsShared();
+
+    WebSocket->OnConnected().AddLambda([WeakThis]() {
+        TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin();
+        if (!This.IsValid())
+        {
+            return;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("UE5 WebSocket Connected to: %s"), *This->NodeUrl);
+        This->OnSessionOpened();
+    });
+
+    WebSocket->OnConnectionError().AddLambda([WeakThis](const FString& Error) {
+        UE_LOG(LogTemp, Error, TEXT("UE5 WebSocket Connection Error: %s"), *Error);
+
+        if (TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin())
+        {
+            This->NotifyConnected(false);
+
+            // Failed attempts feed the same backoff as dropped sessions
+            if (!This->bClosing)
+            {
+                This->OnSessionLost();
+            }
+        }
+    });
+
+    // Decode on a worker; only the typed result comes back to the game thread
+    WebSocket->OnMessage().AddLambda([WeakThis](const FString& MessageStr) {
+        UE_LOG(LogTemp, Verbose, TEXT("UE5 Received WebSocket message: %s"), *MessageStr);
+
+        if (TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin())
+        {
+            This->QueueDecode([MessageStr](FInterverseDecodedPayload& Payload)
+            {
+                Payload.RawMessage = MessageStr;
+                FInterverseConnectionManager::DecodeMessage(MessageStr, Payload);
+            });
+        }
+    });
+
+    // MessagePack frames, once negotiated; large ones can arrive in fragments
+    WebSocket->OnBinaryMessage().AddLambda([WeakThis](const void* Data, SIZE_T Size, bool bIsLastFragment) {
+        TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin();
+        if (!This.IsValid())
+        {
+            return;
+        }
+
+        This->PendingBinaryFrame.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+        if (!bIsLastFragment)
+        {
+            return;
+        }
+
+        TArray<uint8> Frame = MoveTemp(This->PendingBinaryFrame);
+        This->PendingBinaryFrame.Reset();
+        This->QueueDecode([Frame = MoveTemp(Frame)](FInterverseDecodedPayload& Payload)
+        {
+            FInterverseConnectionManager::DecodeBinaryMessage(Frame, Payload);
+        });
+    });
+
+    // UE5 close handler with status code
+    WebSocket->OnClosed().AddLambda([WeakThis](int32 StatusCode, const FString& Reason, bool bWasClean) {
+        UE_LOG(LogTemp, Warning, TEXT("UE5 WebSocket Closed - Status: %d, Reason: %s, Clean: %d"), 
+            StatusCode, *Reason, bWasClean);
+
+        TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin();
+        if (!This.IsValid())
+        {
+            return;
+        }
+
+        This->NotifyConnected(false);
+
+        // Optionally attempt reconnection if wasn't a clean close
+        if (!bWasClean && !This->bClosing)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("UE5 WebSocket connection was not clean, scheduling reconnect"));
+            This->OnSessionLost();
+        }
+    });
+}
+
+void FInterverseSocketConnection::QueueDecode(TFunction<void(FInterverseDecodedPayload& Payload)> Decode)
+{
+    const uint64 Sequence = NextSequence++;
+    INC_DWORD_STAT(STAT_InterversePendingMessages);
+    FInterverseConnectionManager::Get().NoteMessageReceived();
+
+    TWeakPtr<FInterverseSocketConnection> WeakThis = AsShared();
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Sequence, Decode = MoveTemp(Decode)]()
+    {
+        TSharedPtr<FInterverseDecodedPayload> Payload = MakeShared<FInterverseDecodedPayload>();
+        {
+            SCOPE_CYCLE_COUNTER(STAT_InterverseDecodeSocketMessage);
+            Decode(*Payload);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Sequence, Payload]()
+        {
+            if (TSharedPtr<FInterverseSocketConnection> Connection = WeakThis.Pin())
+            {
+                Connection->OnMessageDecoded(Sequence, Payload);
+            }
+        });
+    });
+}
+
+void FInterverseSocketConnection::OnSessionOpened()
+{
+    // The handshake itself is always JSON; binary and batch frames only start once the node answers it
+    NegotiatedFormat = EInterverseWireFormat::Json;
+    bNodeAcceptsBatches = false;
+    bNodeAcceptsHttpMessagePack = false;
+
+    // One handshake per socket, however many components share it
+    if (!GameId.IsEmpty())
+    {
+        TSharedRef<FJsonObject> Handshake = MakeShared<FJsonObject>();
+        Handshake->SetStringField(TEXT("type"), TEXT("handshake"));
+        Handshake->SetStringField(TEXT("game_id"), GameId);
+
+        // last_seq asks the node to replay anything sent while we were away
+        if (LastServerSequence >= 0)
+        {
+            Handshake->SetNumberField(TEXT("last_seq"), static_cast<double>(LastServerSequence));
+            if (!ServerEpoch.IsEmpty())
+            {
+                Handshake->SetStringField(TEXT("epoch"), ServerEpoch);
+            }
+        }
+
+        // Formats in order of preference; nodes that don't know the field just keep talking JSON
+        if (PreferredFormat != EInterverseWireFormat::Json)
+        {
+            TArray<TSharedPtr<FJsonValue>> Formats;
+            Formats.Add(MakeShared<FJsonValueString>(InterverseWire::GetFormatName(PreferredFormat)));
+            Formats.Add(MakeShared<FJsonValueString>(TEXT("json")));
+            Handshake->SetArrayField(TEXT("formats"), Formats);
+        }
+
+        const FString HandshakeMessage = InterverseWire::ToJsonString(Handshake);
+        WebSocket->Send(HandshakeMessage);
+        UE_LOG(LogTemp, Log, TEXT("Sent UE5 handshake: %s"), *HandshakeMessage);
+    }
+
+    // A fresh session starts with no topics on the node side
+    RemoteAddresses.Reset();
+    RemoteAssetIds.Reset();
+    SyncRemoteTopics();
+
+    if (DisconnectedAt > 0.0)
+    {
+        const float RecoverySeconds = static_cast<float>(FPlatformTime::Seconds() - DisconnectedAt);
+        UE_LOG(LogTemp, Log, TEXT("WebSocket recovered after %.2fs and %d attempt(s)"), RecoverySeconds, ReconnectAttempts);
+        FInterverseConnectionManager::Get().NoteReconnected(RecoverySeconds);
+    }
+
+    ReconnectAttempts = 0;
+    DisconnectedAt = 0.0;
+
+    // Anything queued while we were away goes out after the handshake and topics
+    SendAllowanceBytes = 0.0;
+    ScheduleFlush();
+
+    NotifyConnected(true);
+}
+
+void FInterverseSocketConnection::OnSessionLost()
+{
+    if (NumSubscribers() == 0)
+    {
+        return;
+    }
+
+    if (DisconnectedAt <= 0.0)
+    {
+        DisconnectedAt = FPlatformTime::Seconds();
+    }
+
+    ScheduleReconnect();
+}
+
+void FInterverseSocketConnection::Close()
+{
+    CancelReconnect();
+    bClosing = true;
+    ReconnectAttempts = 0;
+    DisconnectedAt = 0.0;
+
+    ClearOutbound();
+    DestroySocket();
+}
+
+void FInterverseSocketConnection::DestroySocket()
+{
+    if (WebSocket.IsValid())
+    {
+        if (WebSocket->IsConnected())
+        {
+            UE_LOG(LogTemp, Log, TEXT("Disconnecting WebSocket"));
+            WebSocket->Close();
+        }
+        WebSocket->OnConnected().Clear();
+        WebSocket->OnConnectionError().Clear();
+        WebSocket->OnMessage().Clear();
+        WebSocket->OnBinaryMessage().Clear();
+        WebSocket->OnClosed().Clear();
+        WebSocket.Reset();
+    }
+    PendingBinaryFrame.Reset();
+}
+
+void FInterverseSocketConnection::Reconnect()
+{
+    UE_LOG(LogTemp, Log, TEXT("Attempting to reconnect WebSocket"));
+
+    // Unlike Close(), keep the outbound queue for the new session
+    CancelReconnect();
+    ReconnectAttempts = 0;
+    DisconnectedAt = 0.0;
+    DestroySocket();
+    Connect();
+}
+
+bool FInterverseSocketConnection::IsConnected() const
+{
+    return WebSocket.IsValid() && WebSocket->IsConnected();
+}
+
+bool FInterverseSocketConnection::Send(const FString& Message)
+{
+    FOutboundMessage Outbound;
+    Outbound.Text = Message;
+
+    // Raw text is spliced into batches as is, so anything that isn't one well-formed object goes out alone
+    if (SendSettings.bCoalesceFrames && Message.StartsWith(TEXT("{")))
+    {
+        TSharedPtr<FJsonObject> Parsed;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+        Outbound.bTextIsObject = FJsonSerializer::Deserialize(Reader, Parsed) && Parsed.IsValid();
+    }
+    return Enqueue(MoveTemp(Outbound));
+}
+
+bool FInterverseSocketConnection::Send(const TSharedRef<FJsonObject>& Message)
+{
+    FOutboundMessage Outbound;
+    if (NegotiatedFormat == EInterverseWireFormat::MessagePack)
+    {
+        InterverseWire::ToMessagePack(Message, Outbound.Packed);
+        Outbound.Object = Message;
+    }
+    else
+    {
+        Outbound.Text = InterverseWire::ToJsonString(Message);
+        Outbound.bTextIsObject = true;
+    }
+    return Enqueue(MoveTemp(Outbound));
+}
+
+bool FInterverseSocketConnection::Enqueue(FOutboundMessage&& Message)
+{
+    // Text is counted in characters; close enough to wire bytes for the mostly-ASCII JSON we send
+    const int32 MessageBytes = Message.GetSize();
+    if (!MakeRoomFor(MessageBytes))
+    {
+        ++OutboundRejected;
+        return false;
+    }
+
+    OutboundQueue.Add(MoveTemp(Message));
+    OutboundQueuedBytes += MessageBytes;
+    INC_DWORD_STAT(STAT_InterverseOutboundQueued);
+
+    OutboundHighWaterMessages = FMath::Max(OutboundHighWaterMessages, OutboundQueue.Num());
+    OutboundHighWaterBytes = FMath::Max(OutboundHighWaterBytes, OutboundQueuedBytes);
+
+    ScheduleFlush();
+    return true;
+}
+
+bool FInterverseSocketConnection::MakeRoomFor(int32 MessageBytes)
+{
+    const int32 MaxMessages = FMath::Max(1, SendSettings.MaxQueuedMessages);
+    const int32 MaxBytes = FMath::Max(1, SendSettings.MaxQueuedBytes);
+
+    auto HasRoom = [&]()
+    {
+        return OutboundQueue.Num() < MaxMessages && OutboundQueuedBytes + MessageBytes <= MaxBytes;
+    };
+
+    if (HasRoom())
+    {
+        return true;
+    }
+
+    // A message bigger than the whole queue can never fit
+    if (MessageBytes > MaxBytes)
+    {
+        return false;
+    }
+
+    switch (SendSettings.OverflowPolicy)
+    {
+    case EInterverseSendOverflowPolicy::DropOldest:
+    {
+        int32 NumToDrop = 0;
+        int32 BytesToDrop = 0;
+        while (NumToDrop < OutboundQueue.Num() &&
+               (OutboundQueue.Num() - NumToDrop >= MaxMessages || OutboundQueuedBytes - BytesToDrop + MessageBytes > MaxBytes))
+        {
+            BytesToDrop += OutboundQueue[NumToDrop].GetSize();
+            ++NumToDrop;
+        }
+
+        OutboundQueue.RemoveAt(0, NumToDrop, EAllowShrinking::No);
+        OutboundQueuedBytes -= BytesToDrop;
+        OutboundDropped += NumToDrop;
+        DEC_DWORD_STAT_BY(STAT_InterverseOutboundQueued, NumToDrop);
+        UE_LOG(LogTemp, Verbose, TEXT("Outbound WebSocket queue full, dropped %d oldest message(s)"), NumToDrop);
+        return true;
+    }
+
+    case EInterverseSendOverflowPolicy::Block:
+        // Sockets live on the game thread, so the producer waits by draining the queue itself
+        if (IsConnected())
+        {
+            DrainOutbound(TNumericLimits<double>::Max());
+            return HasRoom();
+        }
+        return false;
+
+    case EInterverseSendOverflowPolicy::Reject:
+    default:
+        return false;
+    }
+}
+
+void FInterverseSocketConnection::ScheduleFlush()
+{
+    if (FlushTickerHandle.IsValid() || OutboundQueue.Num() == 0)
+    {
+        return;
+    }
+
+    // Flush on the next tick so messages queued together in a frame can share a socket frame
+    TWeakPtr<FInterverseSocketConnection> WeakThis = AsShared();
+    FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([WeakThis](float DeltaTime)
+        {
+            TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin();
+            return This.IsValid() && This->FlushOutbound(DeltaTime);
+        }));
+}
+
+bool FInterverseSocketConnection::FlushOutbound(float DeltaTime)
+{
+    // Nothing drains while disconnected; the next session restarts the flush
+    if (!IsConnected() || OutboundQueue.Num() == 0)
+    {
+        FlushTickerHandle.Reset();
+        return false;
+    }
+
+    double Budget = TNumericLimits<double>::Max();
+    if (SendSettings.MaxBytesPerSecond > 0)
+    {
+        // Token bucket allowing at most one second of burst
+        SendAllowanceBytes = FMath::Min<double>(SendAllowanceBytes + DeltaTime * SendSettings.MaxBytesPerSecond, SendSettings.MaxBytesPerSecond);
+        Budget = SendAllowanceBytes;
+    }
+
+    DrainOutbound(Budget);
+
+    if (OutboundQueue.Num() == 0)
+    {
+        FlushTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FInterverseSocketConnection::DrainOutbound(double ByteBudget)
+{
+    const bool bRateLimited = ByteBudget < TNumericLimits<double>::Max();
+    const bool bBinarySession = NegotiatedFormat == EInterverseWireFormat::MessagePack;
+    const bool bCoalesce = SendSettings.bCoalesceFrames && bNodeAcceptsBatches;
+
+    // Packed messages go out as text if this session fell back to JSON
+    auto IsBinary = [bBinarySession](const FOutboundMessage& Message)
+    {
+        return bBinarySession && Message.Packed.Num() > 0;
+    };
+    auto GetText = [](const FOutboundMessage& Message)
+    {
+        return Message.Packed.Num() > 0 && Message.Object.IsValid() ? InterverseWire::ToJsonString(Message.Object.ToSharedRef()) : Message.Text;
+    };
+    auto IsObject = [](const FOutboundMessage& Message)
+    {
+        return Message.Object.IsValid() || Message.bTextIsObject;
+    };
+
+    int32 Consumed = 0;
+    int32 ConsumedBytes = 0;
+    while (Consumed < OutboundQueue.Num() && ByteBudget > 0.0)
+    {
+        const FOutboundMessage& First = OutboundQueue[Consumed];
+        const bool bBinaryFrame = IsBinary(First);
+
+        // Only objects can go inside a batch envelope, and only alongside messages in the same encoding
+        int32 FrameEnd = Consumed + 1;
+        int32 FrameBytes = First.GetSize();
+        if (bCoalesce && IsObject(First))
+        {
+            while (FrameEnd < OutboundQueue.Num() &&
+                   IsBinary(OutboundQueue[FrameEnd]) == bBinaryFrame &&
+                   IsObject(OutboundQueue[FrameEnd]) &&
+                   FrameBytes + OutboundQueue[FrameEnd].GetSize() + 1 <= SendSettings.MaxCoalescedFrameBytes)
+            {
+                FrameBytes += OutboundQueue[FrameEnd].GetSize() + 1;
+                ++FrameEnd;
+            }
+        }
+
+        if (bBinaryFrame)
+        {
+            if (FrameEnd - Consumed == 1)
+            {
+                WebSocket->Send(First.Packed.GetData(), First.Packed.Num(), true);
+            }
+            else
+            {
+                // Members are already encoded, so the envelope is spliced around them
+                TArray<uint8> Frame;
+                Frame.Reserve(FrameBytes + 32);
+                InterverseWire::AppendMapHeader(Frame, 2);
+                InterverseWire::AppendString(Frame, TEXT("type"));
+                InterverseWire::AppendString(Frame, TEXT("batch"));
+                InterverseWire::AppendString(Frame, TEXT("messages"));
+                InterverseWire::AppendArrayHeader(Frame, FrameEnd - Consumed);
+                for (int32 Index = Consumed; Index < FrameEnd; ++Index)
+                {
+                    Frame.Append(OutboundQueue[Index].Packed);
+                }
+                WebSocket->Send(Frame.GetData(), Frame.Num(), true);
+            }
+            INC_DWORD_STAT(STAT_InterverseBinaryFramesSent);
+        }
+        else if (FrameEnd - Consumed == 1)
+        {
+            WebSocket->Send(GetText(First));
+        }
+        else
+        {
+            FString Frame;
+            Frame.Reserve(FrameBytes + 40);
+            Frame += TEXT("{\"type\":\"batch\",\"messages\":[");
+            for (int32 Index = Consumed; Index < FrameEnd; ++Index)
+            {
+                if (Index > Consumed)
+                {
+                    Frame += TEXT(",");
+                }
+                Frame += GetText(OutboundQueue[Index]);
+            }
+            Frame += TEXT("]}");
+            WebSocket->Send(Frame);
+        }
+
+        for (int32 Index = Consumed; Index < FrameEnd; ++Index)
+        {
+            ConsumedBytes += OutboundQueue[Index].GetSize();
+        }
+
+        OutboundMessagesSent += FrameEnd - Consumed;
+        ++OutboundFramesSent;
+        INC_DWORD_STAT(STAT_InterverseFramesSent);
+
+        ByteBudget -= FrameBytes;
+        Consumed = FrameEnd;
+    }
+
+    // An oversized frame leaves the bucket in debt, which later ticks pay back
+    if (bRateLimited)
+    {
+        SendAllowanceBytes = ByteBudget;
+    }
+
+    OutboundQueue.RemoveAt(0, Consumed, EAllowShrinking::No);
+    OutboundQueuedBytes -= ConsumedBytes;
+    DEC_DWORD_STAT_BY(STAT_InterverseOutboundQueued, Consumed);
+}
+
+bool FInterverseSocketConnection::HasSettings(float InReconnectDelay, float InMaxReconnectDelay, const FInterverseSendQueueSettings& InSendSettings, EInterverseWireFormat InPreferredFormat) const
+{
+    return FMath::IsNearlyEqual(ReconnectDelay, InReconnectDelay) &&
+           FMath::IsNearlyEqual(MaxReconnectDelay, InMaxReconnectDelay) &&
+           PreferredFormat == InPreferredFormat &&
+           SendSettings.MaxQueuedMessages == InSendSettings.MaxQueuedMessages &&
+           SendSettings.MaxQueuedBytes == InSendSettings.MaxQueuedBytes &&
+           SendSettings.OverflowPolicy == InSendSettings.OverflowPolicy &&
+           SendSettings.bCoalesceFrames == InSendSettings.bCoalesceFrames &&
+           SendSettings.MaxCoalescedFrameBytes == InSendSettings.MaxCoalescedFrameBytes &&
+           SendSettings.MaxBytesPerSecond == InSendSettings.MaxBytesPerSecond;
+}
+
+void FInterverseSocketConnection::ClearOutbound()
+{
+    if (FlushTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+        FlushTickerHandle.Reset();
+    }
+
+    DEC_DWORD_STAT_BY(STAT_InterverseOutboundQueued, OutboundQueue.Num());
+    OutboundQueue.Reset();
+    OutboundQueuedBytes = 0;
+}
+
+void FInterverseSocketConnection::AccumulateStats(FInterverseSocketStats& Stats) const
+{
+    Stats.OutboundQueued += OutboundQueue.Num();
+    Stats.OutboundQueuedBytes += OutboundQueuedBytes;
+    Stats.OutboundHighWaterMessages = FMath::Max(Stats.OutboundHighWaterMessages, OutboundHighWaterMessages);
+    Stats.OutboundHighWaterBytes = FMath::Max(Stats.OutboundHighWaterBytes, OutboundHighWaterBytes);
+    Stats.OutboundMessagesSent += OutboundMessagesSent;
+    Stats.OutboundFramesSent += OutboundFramesSent;
+    Stats.OutboundDropped += OutboundDropped;
+    Stats.OutboundRejected += OutboundRejected;
+}
+
+void FInterverseSocketConnection::OnMessageDecoded(uint64 Sequence, TSharedPtr<FInterverseDecodedPayload> Payload)
+{
+    // Workers can finish out of order, so hold results until every earlier message has been routed
+    DecodedMessages.Add(Sequence, Payload);
+
+    TSharedPtr<FInterverseDecodedPayload> Next;
+    while (DecodedMessages.RemoveAndCopyValue(NextSequenceToRoute, Next))
+    {
+        ++NextSequenceToRoute;
+        DEC_DWORD_STAT(STAT_InterversePendingMessages);
+
+        // The ack may start a new sequence epoch, so it is applied before any duplicate check
+        const bool bHandshakeAck = Next->Type == InterverseMessageTypes::HandshakeAck;
+        if (bHandshakeAck)
+        {
+            ApplyHandshakeAck(*Next);
+        }
+
+        // Replays after a reconnect can overlap what we already saw
+        if (Next->ServerSequence >= 0)
+        {
+            if (Next->ServerSequence <= LastServerSequence && !bHandshakeAck)
+            {
+                continue;
+            }
+            LastServerSequence = FMath::Max(LastServerSequence, Next->ServerSequence);
+        }
+
+        RouteMessage(*Next);
+    }
+}
+
+void FInterverseSocketConnection::ApplyHandshakeAck(const FInterverseDecodedPayload& Payload)
+{
+    RebaseServerSequence(Payload);
+
+    // Batch envelopes and MessagePack request bodies are only sent to nodes that list them among their capabilities
+    const TArray<TSharedPtr<FJsonValue>>* Capabilities = nullptr;
+    if (Payload.Json.IsValid() && Payload.Json->TryGetArrayField(TEXT("capabilities"), Capabilities))
+    {
+        for (const TSharedPtr<FJsonValue>& Capability : *Capabilities)
+        {
+            const FString Name = Capability.IsValid() ? Capability->AsString() : FString();
+            bNodeAcceptsBatches |= Name == TEXT("batch");
+            bNodeAcceptsHttpMessagePack |= Name == TEXT("http_msgpack");
+        }
+    }
+
+    FString FormatName;
+    EInterverseWireFormat Format;
+    if (!Payload.Json.IsValid() || !Payload.Json->TryGetStringField(TEXT("format"), FormatName) || !InterverseWire::FindFormat(FormatName, Format))
+    {
+        return;
+    }
+
+    // Only switch to something we offered
+    if (Format != PreferredFormat && Format != EInterverseWireFormat::Json)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Node chose unoffered wire format '%s', staying on JSON"), *FormatName);
+        return;
+    }
+
+    NegotiatedFormat = Format;
+    UE_LOG(LogTemp, Log, TEXT("WebSocket to %s using %s frames"), *NodeUrl, InterverseWire::GetFormatName(Format));
+}
+
+void FInterverseSocketConnection::RebaseServerSequence(const FInterverseDecodedPayload& Payload)
+{
+    if (!Payload.Json.IsValid())
+    {
+        return;
+    }
+
+    // A node that restarted numbers from zero again; a new epoch, or a sequence behind ours
+    // when the node doesn't report one, means what we saw belongs to the old numbering
+    FString Epoch;
+    const bool bHasEpoch = Payload.Json->TryGetStringField(TEXT("epoch"), Epoch) && !Epoch.IsEmpty();
+    const bool bNewEpoch = bHasEpoch && !ServerEpoch.IsEmpty() && Epoch != ServerEpoch;
+    const bool bSequenceBehind = !bHasEpoch && Payload.ServerSequence >= 0 && Payload.ServerSequence < LastServerSequence;
+
+    if (bNewEpoch || bSequenceBehind)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Node %s restarted its message sequence, resetting from %lld"), *NodeUrl, LastServerSequence);
+        LastServerSequence = -1;
+    }
+
+    if (bHasEpoch)
+    {
+        ServerEpoch = Epoch;
+    }
+}
+
+void FInterverseSocketConnection::RouteMessage(const FInterverseDecodedPayload& Payload)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseRouteSocketMessage);
+
+    // Handlers may unsubscribe while we iterate, so route over a snapshot of the handles
+    TArray<int32> Handles;
+    Subscribers.GetKeys(Handles);
+
+    int32 Routed = 0;
+    int32 Filtered = 0;
+    for (int32 Handle : Handles)
+    {
+        const FInterverseSocketSubscriber* Subscriber = Subscribers.Find(Handle);
+        if (!Subscriber || !Subscriber->Owner.IsValid())
+        {
+            continue;
+        }
+
+        if (!SubscriberWants(*Subscriber, Payload))
+        {
+            ++Filtered;
+            continue;
+        }
+
+        // The handler can add or remove subscribers, which may reallocate the map under Subscriber
+        if (TFunction<void(const FInterverseDecodedPayload&)> OnMessage = Subscriber->OnMessage)
+        {
+            OnMessage(Payload);
+            ++Routed;
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_InterverseMessagesRouted, Routed);
+    FInterverseConnectionManager::Get().NoteMessagesRouted(Routed, Filtered);
+}
+
+void FInterverseSocketConnection::NotifyConnected(bool bConnected)
+{
+    TArray<int32> Handles;
+    Subscribers.GetKeys(Handles);
+
+    for (int32 Handle : Handles)
+    {
+        const FInterverseSocketSubscriber* Subscriber = Subscribers.Find(Handle);
+        if (!Subscriber || !Subscriber->Owner.IsValid())
+        {
+            continue;
+        }
+
+        // Copied for the same reason as in RouteMessage
+        if (TFunction<void(bool)> OnConnected = Subscriber->OnConnected)
+        {
+            OnConnected(bConnected);
+        }
+    }
+}
+
+void FInterverseSocketConnection::SyncRemoteTopics()
+{
+    if (!IsConnected())
+    {
+        // Topics are sent in full once the next session's handshake completes
+        return;
+    }
+
+    TSet<FString> WantedAddresses;
+    TSet<FString> WantedAssetIds;
+    for (const TPair<int32, FInterverseSocketSubscriber>& Pair : Subscribers)
+    {
+        const FInterverseSocketSubscriber& Subscriber = Pair.Value;
+        if (!Subscriber.Owner.IsValid())
+        {
+            continue;
+        }
+
+        // An unfiltered subscriber needs the whole feed, which is what the node sends with no topics
+        if (Subscriber.Addresses.Num() == 0 && Subscriber.AssetIds.Num() == 0)
+        {
+            WantedAddresses.Reset();
+            WantedAssetIds.Reset();
+            break;
+        }
+
+        WantedAddresses.Append(Subscriber.Addresses);
+        WantedAssetIds.Append(Subscriber.AssetIds);
+    }
+
+    // Only the difference goes over the wire
+    SendTopicMessage(TEXT("unsubscribe"), RemoteAddresses.Difference(WantedAddresses), RemoteAssetIds.Difference(WantedAssetIds));
+    SendTopicMessage(TEXT("subscribe"), WantedAddresses.Difference(RemoteAddresses), WantedAssetIds.Difference(RemoteAssetIds));
+
+    RemoteAddresses = MoveTemp(WantedAddresses);
+    RemoteAssetIds = MoveTemp(WantedAssetIds);
+}
+
+void FInterverseSocketConnection::SendTopicMessage(const TCHAR* Type, const TSet<FString>& Addresses, const TSet<FString>& AssetIds)
+{
+    if (Addresses.Num() == 0 && AssetIds.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> AddressValues;
+    for (const FString& Address : Addresses)
+    {
+        AddressValues.Add(MakeShared<FJsonValueString>(Address));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> AssetValues;
+    for (const FString& AssetId : AssetIds)
+    {
+        AssetValues.Add(MakeShared<FJsonValueString>(AssetId));
+    }
+
+    TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    JsonObject->SetStringField(TEXT("type"), Type);
+    JsonObject->SetArrayField(TEXT("addresses"), AddressValues);
+    JsonObject->SetArrayField(TEXT("asset_ids"), AssetValues);
+
+    UE_LOG(LogTemp, Verbose, TEXT("Sending topic update: %s"), *InterverseWire::ToJsonString(JsonObject));
+    SendNow(JsonObject);
+}
+
+void FInterverseSocketConnection::SendNow(const TSharedRef<FJsonObject>& Message)
+{
+    if (NegotiatedFormat == EInterverseWireFormat::MessagePack)
+    {
+        TArray<uint8> Packed;
+        InterverseWire::ToMessagePack(Message, Packed);
+        WebSocket->Send(Packed.GetData(), Packed.Num(), true);
+    }
+    else
+    {
+        WebSocket->Send(InterverseWire::ToJsonString(Message));
+    }
+}
+
+void FInterverseSocketConnection::ScheduleReconnect()
+{
+    CancelReconnect();
+
+    const float Delay = GetNextReconnectDelay();
+    ++ReconnectAttempts;
+    UE_LOG(LogTemp, Log, TEXT("WebSocket reconnect attempt %d in %.2fs"), ReconnectAttempts, Delay);
+
+    TWeakPtr<FInterverseSocketConnection> WeakThis = AsShared();
+    ReconnectTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([WeakThis](float)
+        {
+            if (TSharedPtr<FInterverseSocketConnection> This = WeakThis.Pin())
+            {
+                // Keep the backoff state; Close() would reset it
+                This->ReconnectTickerHandle.Reset();
+                This->DestroySocket();
+                This->Connect();
+            }
+            return false;
+        }),
+        Delay);
+}
+
+float FInterverseSocketConnection::GetNextReconnectDelay() const
+{
+    // Exponential backoff capped at MaxReconnectDelay, with jitter so clients
+    // dropped by the same node restart don't all come back at once
+    const float Exponential = ReconnectDelay * FMath::Pow(2.0f, static_cast<float>(FMath::Min(ReconnectAttempts, 16)));
+    const float Capped = FMath::Min(Exponential, MaxReconnectDelay);
+    return Capped * FMath::FRandRange(0.5f, 1.0f);
+}
+
+void FInterverseSocketConnection::CancelReconnect()
+{
+    if (ReconnectTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(ReconnectTickerHandle);
+        ReconnectTickerHandle.Reset();
+    }
+}
+
+bool FInterverseSocketConnection::SubscriberWants(const FInterverseSocketSubscriber& Subscriber, const FInterverseDecodedPayload& Payload)
+{
+    if (Subscriber.Addresses.Num() == 0 && Subscriber.AssetIds.Num() == 0)
+    {
+        return true;
+    }
+
+    const FString& Address = !Payload.Address.IsEmpty() ? Payload.Address : Payload.Asset.Owner;
+    const FString& AssetId = !Payload.AssetId.IsEmpty() ? Payload.AssetId : Payload.Asset.AssetId;
+
+    // Messages that name no wallet or asset (acks, notices) go to everyone
+    if (Address.IsEmpty() && AssetId.IsEmpty())
+    {
+        return true;
+    }
+
+    return (!Address.IsEmpty() && Subscriber.Addresses.Contains(Address)) ||
+           (!AssetId.IsEmpty() && Subscriber.AssetIds.Contains(AssetId));
+}
+
+FInterverseConnectionManager& FInterverseConnectionManager::Get()
+{
+    static FInterverseConnectionManager Manager;
+    return Manager;
+}
+
+TSharedRef<FInterverseSocketConnection> FInterverseConnectionManager::Acquire(
+    const FString& NodeUrl,
+    const FString& ApiKey,
+    const FString& GameId,
+    float ReconnectDelay,
+    float MaxReconnectDelay,
+    const FInterverseSendQueueSettings& SendSettings,
+    EInterverseWireFormat PreferredFormat)
+{
+    check(IsInGameThread());
+
+    const FString Key = MakeKey(NodeUrl, ApiKey, GameId);
+    if (TSharedRef<FInterverseSocketConnection>* Existing = Connections.Find(Key))
+    {
+        if (!(*Existing)->HasSettings(ReconnectDelay, MaxReconnectDelay, SendSettings, PreferredFormat))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Socket to %s for game '%s' is already open with different reconnect, send queue or wire format settings; keeping the first ones"), *NodeUrl, *GameId);
+        }
+        return *Existing;
+    }
+
+    TSharedRef<FInterverseSocketConnection> Connection = MakeShared<FInterverseSocketConnection>(NodeUrl, ApiKey, GameId, ReconnectDelay, MaxReconnectDelay, SendSettings, PreferredFormat);
+    Connections.Add(Key, Connection);
+    return Connection;
+}
+
+void FInterverseConnectionManager::Release(const TSharedPtr<FInterverseSocketConnection>& Connection)
+{
+    check(IsInGameThread());
+
+    if (!Connection.IsValid() || Connection->NumSubscribers() > 0)
+    {
+        return;
+    }
+
+    for (auto It = Connections.CreateIterator(); It; ++It)
+    {
+        if (It->Value == Connection)
+        {
+            Connection->Close();
+            It.RemoveCurrent();
+            break;
+        }
+    }
+}
+
+void FInterverseConnectionManager::Shutdown()
+{
+    for (const TPair<FString, TSharedRef<FInterverseSocketConnection>>& Pair : Connections)
+    {
+        Pair.Value->Close();
+    }
+    Connections.Empty();
+}
+
+FInterverseSocketStats FInterverseConnectionManager::GetStats() const
+{
+    FInterverseSocketStats Stats;
+    for (const TPair<FString, TSharedRef<FInterverseSocketConnection>>& Pair : Connections)
+    {
+        if (Pair.Value->IsCreated())
+        {
+            Stats.OpenSockets++;
+        }
+        Stats.Subscribers += Pair.Value->NumSubscribers();
+        Pair.Value->AccumulateStats(Stats);
+    }
+    Stats.MessagesReceived = MessagesReceived;
+    Stats.MessagesRouted = MessagesRouted;
+    Stats.MessagesRoutedPerSecond = MessagesRoutedPerSecond;
+    Stats.MessagesFiltered = MessagesFiltered;
+    Stats.Reconnects = Reconnects;
+    Stats.LastRecoverySeconds = LastRecoverySeconds;
+    Stats.LongestRecoverySeconds = LongestRecoverySeconds;
+    return Stats;
+}
+
+void FInterverseConnectionManager::NoteMessageReceived()
+{
+    MessagesReceived++;
+}
+
+void FInterverseConnectionManager::NoteReconnected(float RecoverySeconds)
+{
+    Reconnects++;
+    LastRecoverySeconds = RecoverySeconds;
+    LongestRecoverySeconds = FMath::Max(LongestRecoverySeconds, RecoverySeconds);
+}
+
+void FInterverseConnectionManager::NoteMessagesRouted(int32 Count, int32 Filtered)
+{
+    MessagesRouted += Count;
+    MessagesFiltered += Filtered;
+
+    // Rate over the last full one-second window
+    const double Now = FPlatformTime::Seconds();
+    if (RateWindowStart == 0.0)
+    {
+        RateWindowStart = Now;
+    }
+
+    RateWindowCount += Count;
+    const double Elapsed = Now - RateWindowStart;
+    if (Elapsed >= 1.0)
+    {
+        MessagesRoutedPerSecond = static_cast<float>(RateWindowCount / Elapsed);
+        RateWindowStart = Now;
+        RateWindowCount = 0;
+    }
+}
+
+FString FInterverseConnectionManager::MakeKey(const FString& NodeUrl, const FString& ApiKey, const FString& GameId)
+{
+    FString Url = NodeUrl;
+    while (Url.EndsWith(TEXT("/")))
+    {
+        Url.LeftChopInline(1);
+    }
+    return Url + TEXT("|") + ApiKey + TEXT("|") + GameId;
+}
+
+void FInterverseConnectionManager::DecodeMessage(const FString& Message, FInterverseDecodedPayload& Out)
+{
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        return;
+    }
+
+    DecodeObject(JsonObject, Out);
+}
+
+void FInterverseConnectionManager::DecodeBinaryMessage(TArrayView<const uint8> Message, FInterverseDecodedPayload& Out)
+{
+    TSharedPtr<FJsonObject> JsonObject = InterverseWire::FromMessagePack(Message);
+    if (!JsonObject.IsValid())
+    {
+        return;
+    }
+
+    // Blueprint listeners of OnWebSocketMessage only ever see JSON text
+    Out.RawMessage = InterverseWire::ToJsonString(JsonObject.ToSharedRef());
+    DecodeObject(JsonObject, Out);
+}
+
+void FInterverseConnectionManager::DecodeObject(const TSharedPtr<FJsonObject>& JsonObject, FInterverseDecodedPayload& Out)
+{
+    FString TypeString;
+    JsonObject->TryGetStringField(TEXT("type"), TypeString);
+    JsonObject->TryGetNumberField(TEXT("seq"), Out.ServerSequence);
+
+    Out.Type = FInterverseMessageRegistry::FindType(TypeString);
+    Out.bValid = FInterverseMessageRegistry::Get().Decode(Out.Type, JsonObject, Out);
+}
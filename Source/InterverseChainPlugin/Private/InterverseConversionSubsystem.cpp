@@ -1,4 +1,7 @@
 #include "InterverseConversionTypes.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
 
 void UInterverseConversionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -22,16 +25,80 @@ void UInterverseConversionSubsystem::Initialize(FSubsystemCollectionBase& Collec
     RegisterConversionRule(FantasyToSciFiWeapons);
 }
 
+TSharedRef<const FInterverseCompiledConversionRule> FInterverseCompiledConversionRule::Compile(const FInterverseConversionRule& Rule, int32 RuleIndex)
+{
+    TSharedRef<FInterverseCompiledConversionRule> Compiled = MakeShared<FInterverseCompiledConversionRule>();
+    Compiled->RuleIndex = RuleIndex;
+    Compiled->NumericConversionRates = Rule.NumericConversionRates;
+    Compiled->PropertyMappings = Rule.PropertyMappings;
+
+    if (const FLinearColor* Primary = Rule.ColorMappings.Find(TEXT("Primary")))
+    {
+        Compiled->PrimaryColor = *Primary;
+    }
+    if (const FLinearColor* Secondary = Rule.ColorMappings.Find(TEXT("Secondary")))
+    {
+        Compiled->SecondaryColor = *Secondary;
+    }
+    return Compiled;
+}
+
+void FInterverseCompiledConversionRule::Apply(FInterverseBaseProperties& Properties) const
+{
+    // Apply numeric conversions
+    if (NumericConversionRates.Num() > 0)
+    {
+        for (TPair<FString, float>& Pair : Properties.NumericProperties)
+        {
+            if (const float* ConversionRate = NumericConversionRates.Find(Pair.Key))
+            {
+                Pair.Value *= *ConversionRate;
+            }
+        }
+    }
+
+    // Apply property mappings
+    if (PropertyMappings.Num() > 0)
+    {
+        for (TPair<FString, FString>& Pair : Properties.StringProperties)
+        {
+            if (const FString* Mapped = PropertyMappings.Find(Pair.Value))
+            {
+                Pair.Value = *Mapped;
+            }
+        }
+    }
+
+    // Apply color mappings if available
+    if (PrimaryColor.IsSet())
+    {
+        Properties.PrimaryColor = PrimaryColor.GetValue();
+    }
+    if (SecondaryColor.IsSet())
+    {
+        Properties.SecondaryColor = SecondaryColor.GetValue();
+    }
+}
+
 void UInterverseConversionSubsystem::RegisterConversionRule(const FInterverseConversionRule& Rule)
 {
-    // Remove any existing rule for the same conversion
-    ConversionRules.RemoveAll([&](const FInterverseConversionRule& Existing) {
-        return Existing.FromGameType == Rule.FromGameType &&
-               Existing.ToGameType == Rule.ToGameType &&
-               Existing.ItemCategory == Rule.ItemCategory;
-    });
-    
-    ConversionRules.Add(Rule);
+    // Replace any existing rule for the same conversion in place
+    const FInterverseConversionRuleKey Key(Rule.FromGameType, Rule.ToGameType, Rule.ItemCategory);
+    const FInterverseCompiledConversionRule* Existing = FindCompiledRule(Rule.FromGameType, Rule.ToGameType, Rule.ItemCategory);
+
+    int32 RuleIndex;
+    if (Existing)
+    {
+        RuleIndex = Existing->RuleIndex;
+        ConversionRules[RuleIndex] = Rule;
+    }
+    else
+    {
+        RuleIndex = ConversionRules.Add(Rule);
+    }
+
+    CompiledRules.Add(Key, FInterverseCompiledConversionRule::Compile(Rule, RuleIndex));
+    CompiledRuleCount = ConversionRules.Num();
 }
 
 FInterverseBaseProperties UInterverseConversionSubsystem::ConvertAsset(
@@ -41,43 +108,101 @@ FInterverseBaseProperties UInterverseConversionSubsystem::ConvertAsset(
 {
     FInterverseBaseProperties ConvertedProperties = Properties;
     
-    FInterverseConversionRule* Rule = FindConversionRule(FromGame, ToGame, Properties.Category);
-    if (Rule)
+    if (const FInterverseCompiledConversionRule* Rule = FindCompiledRule(FromGame, ToGame, Properties.Category))
+    {
+        Rule->Apply(ConvertedProperties);
+    }
+    
+    // Allow Blueprint implementations to modify the result
+    OnAssetConverted(Properties, ConvertedProperties, FromGame, ToGame);
+    
+    return ConvertedProperties;
+}
+
+TFuture<TArray<FInterverseBaseProperties>> UInterverseConversionSubsystem::ConvertAssetsBatch(
+    const TArray<FInterverseBaseProperties>& Items,
+    const FString& FromGame,
+    const FString& ToGame,
+    bool bInvokeBlueprintHook)
+{
+    check(IsInGameThread());
+
+    // Snapshot the compiled rules this batch needs so workers never touch the subsystem
+    TMap<EInterverseItemCategory, TSharedPtr<const FInterverseCompiledConversionRule>> BatchRules;
+    for (const FInterverseBaseProperties& Item : Items)
     {
-        // Apply numeric conversions
-        for (const auto& Pair : ConvertedProperties.NumericProperties)
+        if (!BatchRules.Contains(Item.Category))
         {
-            if (Rule->NumericConversionRates.Contains(Pair.Key))
+            TSharedPtr<const FInterverseCompiledConversionRule> Rule;
+            if (FindCompiledRule(FromGame, ToGame, Item.Category))
             {
-                float ConversionRate = Rule->NumericConversionRates[Pair.Key];
-                ConvertedProperties.NumericProperties[Pair.Key] = Pair.Value * ConversionRate;
+                Rule = CompiledRules.FindChecked(FInterverseConversionRuleKey(FromGame, ToGame, Item.Category));
             }
+            BatchRules.Add(Item.Category, Rule);
         }
-        
-        // Apply property mappings
-        for (const auto& Pair : ConvertedProperties.StringProperties)
+    }
+
+    // Skip the game-thread hop entirely when no Blueprint overrides the hook
+    const bool bRunHook = bInvokeBlueprintHook &&
+        GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UInterverseConversionSubsystem, OnAssetConverted));
+
+    TSharedRef<TPromise<TArray<FInterverseBaseProperties>>> Promise = MakeShared<TPromise<TArray<FInterverseBaseProperties>>>();
+    TFuture<TArray<FInterverseBaseProperties>> Future = Promise->GetFuture();
+
+    TSharedRef<const TArray<FInterverseBaseProperties>> Source = MakeShared<const TArray<FInterverseBaseProperties>>(Items);
+    TWeakObjectPtr<UInterverseConversionSubsystem> WeakThis(this);
+
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Promise, Source, BatchRules = MoveTemp(BatchRules), FromGame, ToGame, bRunHook]()
+    {
+        TArray<FInterverseBaseProperties> Converted = *Source;
+        ParallelFor(Converted.Num(), [&Converted, &BatchRules](int32 Index)
         {
-            if (Rule->PropertyMappings.Contains(Pair.Value))
+            FInterverseBaseProperties& Item = Converted[Index];
+            if (const TSharedPtr<const FInterverseCompiledConversionRule>* Rule = BatchRules.Find(Item.Category))
             {
-                ConvertedProperties.StringProperties[Pair.Key] = Rule->PropertyMappings[Pair.Value];
+                if (Rule->IsValid())
+                {
+                    (*Rule)->Apply(Item);
+                }
             }
-        }
-        
-        // Apply color mappings if available
-        if (Rule->ColorMappings.Contains(TEXT("Primary")))
+        });
+
+        if (!bRunHook)
         {
-            ConvertedProperties.PrimaryColor = Rule->ColorMappings[TEXT("Primary")];
+            Promise->SetValue(MoveTemp(Converted));
+            return;
         }
-        if (Rule->ColorMappings.Contains(TEXT("Secondary")))
+
+        // Blueprint code may only run on the game thread
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Promise, Source, Converted = MoveTemp(Converted), FromGame, ToGame]() mutable
         {
-            ConvertedProperties.SecondaryColor = Rule->ColorMappings[TEXT("Secondary")];
-        }
-    }
-    
-    // Allow Blueprint implementations to modify the result
-    OnAssetConverted(Properties, ConvertedProperties, FromGame, ToGame);
-    
-    return ConvertedProperties;
+            if (UInterverseConversionSubsystem* This = WeakThis.Get())
+            {
+                for (int32 Index = 0; Index < Converted.Num(); ++Index)
+                {
+                    This->OnAssetConverted((*Source)[Index], Converted[Index], FromGame, ToGame);
+                }
+            }
+            Promise->SetValue(MoveTemp(Converted));
+        });
+    });
+
+    return Future;
+}
+
+void UInterverseConversionSubsystem::ConvertAssetsBatchAsync(
+    const TArray<FInterverseBaseProperties>& Items,
+    const FString& FromGame,
+    const FString& ToGame,
+    FOnAssetsBatchConverted OnComplete)
+{
+    ConvertAssetsBatch(Items, FromGame, ToGame, true).Next([OnComplete](TArray<FInterverseBaseProperties> Converted)
+    {
+        AsyncTask(ENamedThreads::GameThread, [OnComplete, Converted = MoveTemp(Converted)]()
+        {
+            OnComplete.ExecuteIfBound(Converted);
+        });
+    });
 }
 
 FInterverseConversionRule* UInterverseConversionSubsystem::FindConversionRule(
@@ -85,14 +210,37 @@ FInterverseConversionRule* UInterverseConversionSubsystem::FindConversionRule(
     const FString& ToGame,
     EInterverseItemCategory Category)
 {
-    for (auto& Rule : ConversionRules)
+    const FInterverseCompiledConversionRule* Compiled = FindCompiledRule(FromGame, ToGame, Category);
+    return Compiled ? &ConversionRules[Compiled->RuleIndex] : nullptr;
+}
+
+const FInterverseCompiledConversionRule* UInterverseConversionSubsystem::FindCompiledRule(
+    const FString& FromGame,
+    const FString& ToGame,
+    EInterverseItemCategory Category)
+{
+    if (CompiledRuleCount != ConversionRules.Num())
     {
-        if (Rule.FromGameType == FromGame &&
-            Rule.ToGameType == ToGame &&
-            Rule.ItemCategory == Category)
-        {
-            return &Rule;
-        }
+        RebuildRuleIndex();
     }
-    return nullptr;
-}
\ No newline at end of file
+
+    const TSharedRef<const FInterverseCompiledConversionRule>* Compiled =
+        CompiledRules.Find(FInterverseConversionRuleKey(FromGame, ToGame, Category));
+    return Compiled ? &Compiled->Get() : nullptr;
+}
+
+void UInterverseConversionSubsystem::RebuildRuleIndex()
+{
+    CompiledRules.Reset();
+    CompiledRules.Reserve(ConversionRules.Num());
+
+    // Later entries win, matching the replace-on-register behaviour
+    for (int32 RuleIndex = 0; RuleIndex < ConversionRules.Num(); ++RuleIndex)
+    {
+        const FInterverseConversionRule& Rule = ConversionRules[RuleIndex];
+        CompiledRules.Add(
+            FInterverseConversionRuleKey(Rule.FromGameType, Rule.ToGameType, Rule.ItemCategory),
+            FInterverseCompiledConversionRule::Compile(Rule, RuleIndex));
+    }
+    CompiledRuleCount = ConversionRules.Num();
+}
@@ -1,9 +1,27 @@
 #include "InterverseGameLinkComponent.h"
 #include "InterversePlayerComponent.h" // Include the player component for player ID handling
 #include "Engine/World.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/Actor.h"
 #include "Serialization/JsonSerializer.h"
 #include "InterverseChainComponent.h"
+#include "InterverseSerializationPlan.h"
+#include "InterverseStats.h"
+#include "Async/ParallelFor.h"
+#include "Algo/AllOf.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Serialize Transferred Actor"), STAT_InterverseSerializeActor, STATGROUP_Interverse);
+DECLARE_CYCLE_STAT(TEXT("Deserialize Transferred Actor"), STAT_InterverseDeserializeActor, STATGROUP_Interverse);
+DECLARE_CYCLE_STAT(TEXT("Serialize Transfer Group"), STAT_InterverseSerializeTransferGroup, STATGROUP_Interverse);
+DECLARE_CYCLE_STAT(TEXT("Receive Queue Spawn"), STAT_InterverseReceiveQueueSpawn, STATGROUP_Interverse);
+
+namespace
+{
+    // Below this many actors the task fan-out costs more than it saves
+    constexpr int32 MinParallelSerializeActors = 4;
+}
 
 UInterverseGameLinkComponent::UInterverseGameLinkComponent()
 {
@@ -17,9 +35,31 @@ void UInterverseGameLinkComponent::BeginPlay()
 
 void UInterverseGameLinkComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    ClearSpawnQueue();
+    ClearActorPool();
+    ReleaseClassMappings();
+
     Super::EndPlay(EndPlayReason);
 }
 
+UInterverseChainComponent* UInterverseGameLinkComponent::GetChainComponent()
+{
+    if (!CachedChainComponent.IsValid() && GetOwner())
+    {
+        CachedChainComponent = GetOwner()->FindComponentByClass<UInterverseChainComponent>();
+    }
+    return CachedChainComponent.Get();
+}
+
+UInterversePlayerComponent* UInterverseGameLinkComponent::GetPlayerComponent()
+{
+    if (!CachedPlayerComponent.IsValid() && GetOwner())
+    {
+        CachedPlayerComponent = GetOwner()->FindComponentByClass<UInterversePlayerComponent>();
+    }
+    return CachedPlayerComponent.Get();
+}
+
 bool UInterverseGameLinkComponent::RegisterGameLink(const FGameLinkConfig& LinkConfig)
 {
     if (LinkConfig.TargetGameId.IsEmpty())
@@ -29,10 +69,13 @@ bool UInterverseGameLinkComponent::RegisterGameLink(const FGameLinkConfig& LinkC
 
     // Store or update the link configuration
     GameLinks.Add(LinkConfig.TargetGameId, LinkConfig);
+    ResolveClassMappings(LinkConfig.TargetGameId);
 
     // Create blockchain record
     TSharedPtr<FJsonObject> LinkRecord = MakeShared<FJsonObject>();
-    LinkRecord->SetStringField("source_game", GetOwner()->GetWorld()->GetGameInstance()->GetName());
+    const UWorld* World = GetWorld();
+    const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    LinkRecord->SetStringField("source_game", GameInstance ? GameInstance->GetName() : FString());
     LinkRecord->SetStringField("target_game", LinkConfig.TargetGameId);
     LinkRecord->SetBoolField("direct_transfer", LinkConfig.bAllowDirectObjectTransfer);
 
@@ -48,7 +91,7 @@ bool UInterverseGameLinkComponent::RegisterGameLink(const FGameLinkConfig& LinkC
     LinkRecord->SetArrayField("class_mappings", Mappings);
 
     // Record on blockchain using the chain component
-    if (UInterverseChainComponent* ChainComponent = GetOwner()->FindComponentByClass<UInterverseChainComponent>())
+    if (UInterverseChainComponent* ChainComponent = GetChainComponent())
     {
         // Convert record to string
         FString RecordString;
@@ -71,7 +114,7 @@ bool UInterverseGameLinkComponent::TransferGameObject(AActor* Actor, const FStri
         return false;
     }
     // Get player component for source player ID
-    UInterversePlayerComponent* PlayerComp = GetOwner()->FindComponentByClass<UInterversePlayerComponent>();
+    UInterversePlayerComponent* PlayerComp = GetPlayerComponent();
     if (!PlayerComp)
     {
         return false;
@@ -105,25 +148,186 @@ bool UInterverseGameLinkComponent::TransferGameObject(AActor* Actor, const FStri
     return TransferObjectData(TransferData, TargetGameId);
 }
 
+bool UInterverseGameLinkComponent::TransferGameObjects(const TArray<AActor*>& Actors, const FString& TargetGameId, const FString& TargetPlayerID)
+{
+    const FGameLinkConfig* LinkConfig = GameLinks.Find(TargetGameId);
+    UInterversePlayerComponent* PlayerComp = GetPlayerComponent();
+    if (Actors.Num() == 0 || !LinkConfig || !LinkConfig->bAllowDirectObjectTransfer || !PlayerComp)
+    {
+        return false;
+    }
+
+    UInterverseChainComponent* ChainComp = GetChainComponent();
+    const FString SourcePlayerID = PlayerComp->GetPlayerID().GlobalPlayerID;
+    const FString SourceGameId = ChainComp ? ChainComp->GameId : FString();
+
+    TArray<FGameLinkTransferResult> Results;
+    Results.SetNum(Actors.Num());
+    TArray<int32> PayloadBytes;
+    PayloadBytes.SetNumZeroed(Actors.Num());
+
+    const double StartTime = FPlatformTime::Seconds();
+    {
+        SCOPE_CYCLE_COUNTER(STAT_InterverseSerializeTransferGroup);
+
+        const EInterverseTransferEncoding Encoding = TransferEncoding;
+        auto SerializeOne = [&Actors, &Results, &PayloadBytes, Encoding](int32 Index)
+        {
+            FGameLinkTransferResult& Result = Results[Index];
+            AActor* Actor = Actors[Index];
+            Result.Actor = Actor;
+
+            if (!IsValid(Actor))
+            {
+                Result.Error = TEXT("Invalid actor");
+                return;
+            }
+
+            Result.bSuccess = SerializeActorData(Actor, Encoding, Result.Data, PayloadBytes[Index]);
+            Result.ObjectId = Result.Data.ObjectId;
+            if (!Result.bSuccess)
+            {
+                Result.Error = TEXT("Serialization failed");
+            }
+        };
+
+        // Workers only pack classes whose SaveGame properties are plain data, decided when each plan was built.
+        // References, custom struct serializers and text export can run object-system code, so those stay on the game thread.
+        const bool bParallel = Encoding == EInterverseTransferEncoding::Binary &&
+            Actors.Num() >= MinParallelSerializeActors &&
+            Algo::AllOf(Actors, [](const AActor* Actor)
+            {
+                return !IsValid(Actor) || FInterverseSerializationPlan::Get(Actor->GetClass())->IsPlainData();
+            });
+
+        if (bParallel)
+        {
+            ParallelFor(Actors.Num(), SerializeOne);
+        }
+        else
+        {
+            for (int32 Index = 0; Index < Actors.Num(); ++Index)
+            {
+                SerializeOne(Index);
+            }
+        }
+    }
+
+    TransferStats.LastEncoding = TransferEncoding;
+    TransferStats.LastPayloadBytes = 0;
+    for (int32 Bytes : PayloadBytes)
+    {
+        TransferStats.LastPayloadBytes += Bytes;
+    }
+    TransferStats.LastSerializeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    // One record for the whole group
+    TArray<TSharedPtr<FJsonValue>> ObjectValues;
+    for (FGameLinkTransferResult& Result : Results)
+    {
+        if (!Result.bSuccess)
+        {
+            continue;
+        }
+
+        Result.Data.SourceGameId = SourceGameId;
+        Result.Data.SourcePlayerID = SourcePlayerID;
+        Result.Data.TargetPlayerID = TargetPlayerID;
+
+        TSharedPtr<FJsonObject> ObjectRecord = MakeShared<FJsonObject>();
+        ObjectRecord->SetStringField("object_id", Result.Data.ObjectId);
+        ObjectRecord->SetStringField("object_class", Result.Data.ObjectClass);
+        ObjectValues.Add(MakeShared<FJsonValueObject>(ObjectRecord));
+    }
+
+    if (ObjectValues.Num() == 0)
+    {
+        OnObjectsTransferred.Broadcast(Results, false);
+        return false;
+    }
+
+    TSharedRef<FJsonObject> TransferRecord = MakeShared<FJsonObject>();
+    TransferRecord->SetStringField("type", "game_object_transfer_batch");
+    TransferRecord->SetStringField("source_game", SourceGameId);
+    TransferRecord->SetStringField("target_game", TargetGameId);
+    TransferRecord->SetStringField("source_player", SourcePlayerID);
+    TransferRecord->SetStringField("target_player", TargetPlayerID);
+    TransferRecord->SetNumberField("timestamp", FDateTime::UtcNow().ToUnixTimestamp());
+    TransferRecord->SetArrayField("objects", ObjectValues);
+
+    if (!ChainComp)
+    {
+        // Nothing to record against; the transfer stands on serialization alone, as with TransferGameObject
+        const bool bAllSucceeded = ObjectValues.Num() == Results.Num();
+        OnObjectsTransferred.Broadcast(Results, bAllSucceeded);
+        return true;
+    }
+
+    TWeakObjectPtr<UInterverseGameLinkComponent> WeakThis(this);
+    ChainComp->RecordTransaction(TransferRecord, [WeakThis, Results = MoveTemp(Results)](bool bRecorded, const FString& Response) mutable
+    {
+        UInterverseGameLinkComponent* This = WeakThis.Get();
+        if (!This)
+        {
+            return;
+        }
+
+        bool bAllSucceeded = true;
+        for (FGameLinkTransferResult& Result : Results)
+        {
+            if (Result.bSuccess && !bRecorded)
+            {
+                Result.bSuccess = false;
+                Result.Error = TEXT("On-chain record failed");
+            }
+            bAllSucceeded &= Result.bSuccess;
+        }
+
+        This->OnObjectsTransferred.Broadcast(Results, bAllSucceeded);
+    });
+    return true;
+}
+
 bool UInterverseGameLinkComponent::SerializeActor(AActor* Actor, FTransferredObjectData& OutData)
 {
     if (!Actor)
         return false;
 
+    const double StartTime = FPlatformTime::Seconds();
+
+    int32 PayloadBytes = 0;
+    const bool bSerialized = SerializeActorData(Actor, TransferEncoding, OutData, PayloadBytes);
+
+    TransferStats.LastEncoding = TransferEncoding;
+    TransferStats.LastPayloadBytes = PayloadBytes;
+    TransferStats.LastSerializeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return bSerialized;
+}
+
+bool UInterverseGameLinkComponent::SerializeActorData(AActor* Actor, EInterverseTransferEncoding Encoding, FTransferredObjectData& OutData, int32& OutPayloadBytes)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseSerializeActor);
+
     // Generate transfer ID
     OutData.ObjectId = FGuid::NewGuid().ToString();
     OutData.ObjectClass = Actor->GetClass()->GetPathName();
-    
-    // Serialize properties
-    for (TFieldIterator<FProperty> PropIt(Actor->GetClass()); PropIt; ++PropIt)
+
+    // Serialize properties from the class's cached SaveGame plan
+    const TSharedRef<const FInterverseSerializationPlan> Plan = FInterverseSerializationPlan::Get(Actor->GetClass());
+    OutData.Encoding = Encoding;
+    if (Encoding == EInterverseTransferEncoding::Binary)
     {
-        FProperty* Property = *PropIt;
-        if (Property->HasAnyPropertyFlags(CPF_SaveGame))
+        Plan->WriteBinary(Actor, OutData.PropertyData);
+        OutPayloadBytes = OutData.PropertyData.Num();
+    }
+    else
+    {
+        Plan->WriteText(Actor, OutData.ObjectData);
+
+        OutPayloadBytes = 0;
+        for (const TPair<FString, FString>& Pair : OutData.ObjectData)
         {
-            void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Actor);
-            FString ValueString;
-            Property->ExportTextItem_Direct(ValueString, PropertyValue, PropertyValue, Actor, PPF_None);
-            OutData.ObjectData.Add(Property->GetName(), ValueString);
+            OutPayloadBytes += Pair.Key.Len() + Pair.Value.Len();
         }
     }
 
@@ -138,32 +342,64 @@ AActor* UInterverseGameLinkComponent::SpawnReceivedObject(const FTransferredObje
         return nullptr;
     }
 
-    // Find the mapped class for this object
-    UClass* SourceClass = FindObject<UClass>(ANY_PACKAGE, *ObjectData.ObjectClass);
+    bool bStillLoading = false;
+    UClass* TargetClass = ResolveReceivedClass(ObjectData, &bStillLoading);
+    if (!TargetClass)
+    {
+        if (bStillLoading)
+        {
+            WaitForMappedClass(ObjectData);
+        }
+        return nullptr;
+    }
+
+    return SpawnResolvedObject(ObjectData, TargetClass);
+}
+
+UClass* UInterverseGameLinkComponent::ResolveReceivedClass(const FTransferredObjectData& ObjectData, bool* bOutStillLoading) const
+{
+    // ObjectClass is a full path; only classes already in memory are taken
+    UClass* SourceClass = FSoftClassPath(ObjectData.ObjectClass).ResolveClass();
     if (!SourceClass)
     {
         return nullptr;
     }
 
-    UClass* TargetClass = FindMappedClass(SourceClass, ObjectData.SourceGameId);
-    if (!TargetClass)
+    return FindMappedClass(SourceClass, ObjectData.SourceGameId, bOutStillLoading);
+}
+
+AActor* UInterverseGameLinkComponent::SpawnResolvedObject(const FTransferredObjectData& ObjectData, UClass* TargetClass)
+{
+    UWorld* World = GetWorld();
+    if (!World)
     {
         return nullptr;
     }
 
-    // Spawn the actor
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-    
-    AActor* NewActor = GetWorld()->SpawnActor<AActor>(TargetClass, FTransform::Identity, SpawnParams);
+    AActor* NewActor = bPoolReceivedActors ? AcquirePooledActor(TargetClass) : nullptr;
+    const bool bReused = NewActor != nullptr;
     if (!NewActor)
     {
-        return nullptr;
+        // Spawn the actor
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+        NewActor = World->SpawnActor<AActor>(TargetClass, FTransform::Identity, SpawnParams);
+        if (!NewActor)
+        {
+            return nullptr;
+        }
     }
 
     // Apply the deserialized data
     if (DeserializeToActor(ObjectData, NewActor))
     {
+        ReceiveStats.TotalSpawned++;
+        if (bReused)
+        {
+            ReceiveStats.TotalReused++;
+        }
+
         OnObjectReceived.Broadcast(NewActor, ObjectData.SourceGameId);
         return NewActor;
     }
@@ -173,6 +409,200 @@ AActor* UInterverseGameLinkComponent::SpawnReceivedObject(const FTransferredObje
     return nullptr;
 }
 
+int32 UInterverseGameLinkComponent::QueueReceivedObjects(const TArray<FTransferredObjectData>& Objects)
+{
+    // A party of objects usually shares a handful of classes; resolve each pair once
+    struct FClassResolution
+    {
+        UClass* Class = nullptr;
+        bool bStillLoading = false;
+    };
+    TMap<TPair<FString, FString>, FClassResolution> ResolvedClasses;
+
+    int32 NumQueued = 0;
+    for (const FTransferredObjectData& ObjectData : Objects)
+    {
+        if (!ObjectData.bIsValid)
+        {
+            ReceiveStats.TotalFailed++;
+            continue;
+        }
+
+        const TPair<FString, FString> ClassKey(ObjectData.ObjectClass, ObjectData.SourceGameId);
+        FClassResolution* Resolution = ResolvedClasses.Find(ClassKey);
+        if (!Resolution)
+        {
+            Resolution = &ResolvedClasses.Add(ClassKey);
+            Resolution->Class = ResolveReceivedClass(ObjectData, &Resolution->bStillLoading);
+        }
+
+        UClass* TargetClass = Resolution->Class;
+        if (!TargetClass && Resolution->bStillLoading)
+        {
+            WaitForMappedClass(ObjectData);
+            NumQueued++;
+            continue;
+        }
+
+        if (!TargetClass)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Interverse: no class for received object %s (%s)"), *ObjectData.ObjectId, *ObjectData.ObjectClass);
+            ReceiveStats.TotalFailed++;
+            continue;
+        }
+
+        FPendingSpawn& Pending = PendingSpawns.AddDefaulted_GetRef();
+        Pending.Data = ObjectData;
+        Pending.TargetClass = TargetClass;
+        NumQueued++;
+    }
+
+    if (NumQueued > 0 && !SpawnTickerHandle.IsValid())
+    {
+        TWeakObjectPtr<UInterverseGameLinkComponent> WeakThis(this);
+        SpawnTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateLambda([WeakThis](float DeltaTime)
+            {
+                UInterverseGameLinkComponent* This = WeakThis.Get();
+                return This && This->TickSpawnQueue(DeltaTime);
+            }));
+    }
+
+    return NumQueued;
+}
+
+bool UInterverseGameLinkComponent::TickSpawnQueue(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_InterverseReceiveQueueSpawn);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + FMath::Max(SpawnBudgetMs, 0.1f) / 1000.0;
+
+    int32 NumSpawned = 0;
+    while (PendingSpawnHead < PendingSpawns.Num())
+    {
+        FPendingSpawn Pending = MoveTemp(PendingSpawns[PendingSpawnHead++]);
+
+        // The class may have been unloaded while the object waited
+        UClass* TargetClass = Pending.TargetClass.Get();
+        if (!TargetClass || !SpawnResolvedObject(Pending.Data, TargetClass))
+        {
+            ReceiveStats.TotalFailed++;
+        }
+        NumSpawned++;
+
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+
+    const float FrameMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    ReceiveStats.LastFrameSpawns = NumSpawned;
+    ReceiveStats.LastFrameSpawnMs = FrameMs;
+    ReceiveStats.PeakFrameSpawnMs = FMath::Max(ReceiveStats.PeakFrameSpawnMs, FrameMs);
+
+    if (PendingSpawnHead < PendingSpawns.Num())
+    {
+        return true;
+    }
+
+    PendingSpawns.Reset();
+    PendingSpawnHead = 0;
+    SpawnTickerHandle.Reset();
+    return false;
+}
+
+void UInterverseGameLinkComponent::ClearSpawnQueue()
+{
+    if (SpawnTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SpawnTickerHandle);
+        SpawnTickerHandle.Reset();
+    }
+
+    PendingSpawns.Reset();
+    PendingSpawnHead = 0;
+}
+
+void UInterverseGameLinkComponent::ReleaseReceivedObject(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    if (bPoolReceivedActors)
+    {
+        TArray<TWeakObjectPtr<AActor>>& Pool = ActorPool.FindOrAdd(Actor->GetClass());
+        if (Pool.Num() < MaxPooledActorsPerClass)
+        {
+            Actor->SetActorHiddenInGame(true);
+            Actor->SetActorEnableCollision(false);
+            Actor->SetActorTickEnabled(false);
+            Pool.Add(Actor);
+            return;
+        }
+    }
+
+    Actor->Destroy();
+}
+
+AActor* UInterverseGameLinkComponent::AcquirePooledActor(UClass* TargetClass)
+{
+    TArray<TWeakObjectPtr<AActor>>* Pool = ActorPool.Find(TargetClass);
+    if (!Pool)
+    {
+        return nullptr;
+    }
+
+    while (Pool->Num() > 0)
+    {
+        AActor* Actor = Pool->Pop().Get();
+        if (IsValid(Actor))
+        {
+            Actor->SetActorTransform(FTransform::Identity, false, nullptr, ETeleportType::ResetPhysics);
+            Actor->SetActorHiddenInGame(false);
+            Actor->SetActorEnableCollision(true);
+            Actor->SetActorTickEnabled(true);
+            return Actor;
+        }
+    }
+
+    return nullptr;
+}
+
+void UInterverseGameLinkComponent::ClearActorPool()
+{
+    for (TPair<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>>& Pair : ActorPool)
+    {
+        for (const TWeakObjectPtr<AActor>& Pooled : Pair.Value)
+        {
+            if (AActor* Actor = Pooled.Get())
+            {
+                Actor->Destroy();
+            }
+        }
+    }
+    ActorPool.Empty();
+}
+
+FGameLinkReceiveStats UInterverseGameLinkComponent::GetReceiveStats() const
+{
+    FGameLinkReceiveStats Stats = ReceiveStats;
+    Stats.PendingSpawns = PendingSpawns.Num() - PendingSpawnHead;
+    for (const TPair<FString, FResolvedClassMappings>& Pair : ResolvedClassMappings)
+    {
+        Stats.WaitingForClass += Pair.Value.WaitingObjects.Num();
+    }
+    return Stats;
+}
+
+void UInterverseGameLinkComponent::ResetReceiveStats()
+{
+    ReceiveStats = FGameLinkReceiveStats();
+}
+
 bool UInterverseGameLinkComponent::DeserializeToActor(const FTransferredObjectData& Data, AActor* OutActor)
 {
     if (!OutActor)
@@ -180,42 +610,186 @@ bool UInterverseGameLinkComponent::DeserializeToActor(const FTransferredObjectDa
         return false;
     }
 
-    // Apply properties from the transferred data
-     for (const auto& Pair : Data.ObjectData)
+    SCOPE_CYCLE_COUNTER(STAT_InterverseDeserializeActor);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Apply properties from the transferred data; keys the target class lacks are skipped
+    const TSharedRef<const FInterverseSerializationPlan> Plan = FInterverseSerializationPlan::Get(OutActor->GetClass());
+    bool bApplied = true;
+    if (Data.Encoding == EInterverseTransferEncoding::Binary)
     {
-        FProperty* Property = FindFProperty<FProperty>(OutActor->GetClass(), *Pair.Key);
-        if (Property && Property->HasAnyPropertyFlags(CPF_SaveGame))
+        TArray<FSoftObjectPath> Unresolved;
+        bApplied = Plan->ReadBinary(OutActor, Data.PropertyData, &Unresolved);
+
+        // References to assets not in memory yet stream in, then the values are read again to fill them
+        if (bApplied && Unresolved.Num() > 0)
         {
-            void* PropertyValue = Property->ContainerPtrToValuePtr<void>(OutActor);
-            const TCHAR* ImportText = *Pair.Value;
-            Property->ImportText_Direct(ImportText, PropertyValue, OutActor, PPF_None);
+            TWeakObjectPtr<AActor> WeakActor(OutActor);
+            UAssetManager::GetStreamableManager().RequestAsyncLoad(
+                MoveTemp(Unresolved),
+                FStreamableDelegate::CreateLambda([WeakActor, PropertyData = Data.PropertyData]()
+                {
+                    if (AActor* Actor = WeakActor.Get())
+                    {
+                        FInterverseSerializationPlan::Get(Actor->GetClass())->ReadBinary(Actor, PropertyData);
+                    }
+                }));
         }
     }
-    
-    return true;
+    else
+    {
+        Plan->ReadText(OutActor, Data.ObjectData);
+    }
+
+    TransferStats.LastDeserializeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return bApplied;
 }
 
-UClass* UInterverseGameLinkComponent::FindMappedClass(UClass* SourceClass, const FString& TargetGameId) const
+UClass* UInterverseGameLinkComponent::FindMappedClass(UClass* SourceClass, const FString& TargetGameId, bool* bOutStillLoading) const
 {
-    const FGameLinkConfig* Config = GameLinks.Find(TargetGameId);
-    if (!Config)
+    const FResolvedClassMappings* Resolved = ResolvedClassMappings.Find(TargetGameId);
+    if (!Resolved)
     {
         return nullptr;
     }
 
-    // Look up the class mapping
-    for (const auto& Mapping : Config->ClassMappings)
+    if (const TWeakObjectPtr<UClass>* Mapped = Resolved->Classes.Find(SourceClass))
+    {
+        if (UClass* TargetClass = Mapped->Get())
+        {
+            return TargetClass;
+        }
+    }
+
+    // Not in the resolved table: either unmapped, or one side wasn't loaded when it was built
+    if (const TSoftClassPtr<UObject>* Mapped = Resolved->Paths.Find(FSoftObjectPath(SourceClass)))
     {
-        if (Mapping.Key.Get() == SourceClass)
+        // Only ever take an already-loaded class; the preload started at registration brings in the rest
+        UClass* TargetClass = Mapped->Get();
+        if (!TargetClass)
         {
-            return Mapping.Value.Get();
+            const bool bStillLoading = Resolved->LoadHandle.IsValid() && Resolved->LoadHandle->IsLoadingInProgress();
+            if (bOutStillLoading)
+            {
+                *bOutStillLoading = bStillLoading;
+            }
+            if (!bStillLoading)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Interverse: mapped class %s for %s could not be loaded"), *Mapped->ToString(), *SourceClass->GetPathName());
+            }
         }
+        return TargetClass;
     }
 
     // Return the original class if no mapping is found
     return SourceClass;
 }
 
+void UInterverseGameLinkComponent::ResolveClassMappings(const FString& GameId)
+{
+    const FGameLinkConfig* Config = GameLinks.Find(GameId);
+    if (!Config)
+    {
+        return;
+    }
+
+    FResolvedClassMappings& Resolved = ResolvedClassMappings.FindOrAdd(GameId);
+    if (Resolved.LoadHandle.IsValid())
+    {
+        Resolved.LoadHandle->CancelHandle();
+        Resolved.LoadHandle.Reset();
+    }
+
+    Resolved.Paths.Reset();
+    TArray<FSoftObjectPath> TargetPaths;
+    for (const auto& Mapping : Config->ClassMappings)
+    {
+        Resolved.Paths.Add(Mapping.Key.ToSoftObjectPath(), Mapping.Value);
+        if (!Mapping.Value.IsNull())
+        {
+            TargetPaths.AddUnique(Mapping.Value.ToSoftObjectPath());
+        }
+    }
+
+    RebuildResolvedClasses(GameId);
+
+    if (TargetPaths.Num() == 0)
+    {
+        // Objects held for the previous mappings have nothing left to wait for
+        OnClassMappingsLoaded(GameId);
+        return;
+    }
+
+    // Stream the target classes in ahead of any received object so spawning never loads synchronously.
+    // Already-loaded classes complete immediately, and the handle keeps them all referenced.
+    TWeakObjectPtr<UInterverseGameLinkComponent> WeakThis(this);
+    Resolved.LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        TargetPaths,
+        FStreamableDelegate::CreateLambda([WeakThis, GameId]()
+        {
+            if (UInterverseGameLinkComponent* This = WeakThis.Get())
+            {
+                This->OnClassMappingsLoaded(GameId);
+            }
+        }));
+}
+
+void UInterverseGameLinkComponent::OnClassMappingsLoaded(const FString& GameId)
+{
+    RebuildResolvedClasses(GameId);
+
+    FResolvedClassMappings* Resolved = ResolvedClassMappings.Find(GameId);
+    if (!Resolved || Resolved->WaitingObjects.Num() == 0)
+    {
+        return;
+    }
+
+    // Resolve again now that the targets are in; anything that failed to load is dropped with a warning
+    TArray<FTransferredObjectData> Waiting = MoveTemp(Resolved->WaitingObjects);
+    Resolved->WaitingObjects.Reset();
+    QueueReceivedObjects(Waiting);
+}
+
+void UInterverseGameLinkComponent::WaitForMappedClass(const FTransferredObjectData& ObjectData)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("Interverse: holding received object %s until its mapped class loads"), *ObjectData.ObjectId);
+    ResolvedClassMappings.FindOrAdd(ObjectData.SourceGameId).WaitingObjects.Add(ObjectData);
+}
+
+void UInterverseGameLinkComponent::RebuildResolvedClasses(const FString& GameId)
+{
+    FResolvedClassMappings* Resolved = ResolvedClassMappings.Find(GameId);
+    if (!Resolved)
+    {
+        return;
+    }
+
+    Resolved->Classes.Reset();
+    for (const TPair<FSoftObjectPath, TSoftClassPtr<UObject>>& Mapping : Resolved->Paths)
+    {
+        // Source classes are whatever received objects name, so they are looked up but never loaded here
+        UClass* SourceClass = Cast<UClass>(Mapping.Key.ResolveObject());
+        UClass* TargetClass = Mapping.Value.Get();
+        if (SourceClass && TargetClass)
+        {
+            Resolved->Classes.Add(SourceClass, TargetClass);
+        }
+    }
+}
+
+void UInterverseGameLinkComponent::ReleaseClassMappings()
+{
+    for (TPair<FString, FResolvedClassMappings>& Pair : ResolvedClassMappings)
+    {
+        if (Pair.Value.LoadHandle.IsValid())
+        {
+            Pair.Value.LoadHandle->CancelHandle();
+        }
+    }
+    ResolvedClassMappings.Empty();
+}
+
 void UInterverseGameLinkComponent::RecordTransferOnChain(
     const FString& SourceGameId,
     const FString& TargetGameId,
@@ -232,14 +806,10 @@ void UInterverseGameLinkComponent::RecordTransferOnChain(
     TransferRecord->SetStringField("target_player", TargetPlayerID);
     TransferRecord->SetNumberField("timestamp", FDateTime::UtcNow().ToUnixTimestamp());
 
-    FString SerializedRecord;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&SerializedRecord);
-    FJsonSerializer::Serialize(TransferRecord.ToSharedRef(), Writer);
-
-    if (UInterverseChainComponent* ChainComp = GetOwner()->FindComponentByClass<UInterverseChainComponent>())
+    if (UInterverseChainComponent* ChainComp = GetChainComponent())
     {
         // Send to blockchain
-        ChainComp->RecordTransaction(SerializedRecord);
+        ChainComp->RecordTransaction(TransferRecord.ToSharedRef());
     }
 
     OnObjectTransferred.Broadcast(ObjectId, TargetPlayerID, true);
@@ -0,0 +1,261 @@
+#include "InterverseHttpDispatcher.h"
+
+namespace
+{
+    TMap<FString, TWeakPtr<FInterverseHttpDispatcher>>& GetDispatchers()
+    {
+        static TMap<FString, TWeakPtr<FInterverseHttpDispatcher>> Dispatchers;
+        return Dispatchers;
+    }
+
+    // URLs that differ only in trailing slashes name the same node
+    FStringView TrimNodeUrl(const FString& NodeUrl)
+    {
+        FStringView Url(NodeUrl);
+        while (Url.EndsWith(TEXT('/')))
+        {
+            Url.LeftChopInline(1);
+        }
+        return Url;
+    }
+}
+
+FInterverseHttpDispatcher::FInterverseHttpDispatcher()
+{
+}
+
+TSharedRef<FInterverseHttpDispatcher> FInterverseHttpDispatcher::Acquire(const FString& NodeUrl, const FString& ApiKey)
+{
+    check(IsInGameThread());
+
+    TMap<FString, TWeakPtr<FInterverseHttpDispatcher>>& Dispatchers = GetDispatchers();
+    const FString Key = FString(TrimNodeUrl(NodeUrl)) + TEXT("|") + ApiKey;
+    if (TSharedPtr<FInterverseHttpDispatcher> Existing = Dispatchers.FindRef(Key).Pin())
+    {
+        return Existing.ToSharedRef();
+    }
+
+    // Drop entries whose dispatchers are gone while we are here
+    for (auto It = Dispatchers.CreateIterator(); It; ++It)
+    {
+        if (!It->Value.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TSharedRef<FInterverseHttpDispatcher> Dispatcher = MakeShared<FInterverseHttpDispatcher>();
+    Dispatchers.Add(Key, Dispatcher);
+    return Dispatcher;
+}
+
+bool FInterverseHttpDispatcher::IsConfiguredFor(const FString& NodeUrl, const FString& ApiKey) const
+{
+    return TrimNodeUrl(NodeUrl).Equals(ConfiguredNodeUrl, ESearchCase::CaseSensitive) && ApiKey == ConfiguredApiKey && !UrlPrefix.IsEmpty();
+}
+
+void FInterverseHttpDispatcher::Configure(const FString& NodeUrl, const FString& ApiKey, int32 MaxConcurrentRequests)
+{
+    MaxInFlight = FMath::Max(MaxConcurrentRequests, 1);
+
+    if (IsConfiguredFor(NodeUrl, ApiKey))
+    {
+        return;
+    }
+
+    ConfiguredNodeUrl = FString(TrimNodeUrl(NodeUrl));
+    ConfiguredApiKey = ApiKey;
+    UrlPrefix = ConfiguredNodeUrl + TEXT("/");
+
+    CommonHeaders.Reset();
+    CommonHeaders.Emplace(TEXT("X-API-Key"), ApiKey);
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FInterverseHttpDispatcher::CreateRequest(const FString& Verb, const FString& Path) const
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(UrlPrefix + Path);
+    Request->SetVerb(Verb);
+    for (const TPair<FString, FString>& Header : CommonHeaders)
+    {
+        Request->SetHeader(Header.Key, Header.Value);
+    }
+    if (Verb == TEXT("POST") || Verb == TEXT("PUT"))
+    {
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+    }
+    return Request;
+}
+
+void FInterverseHttpDispatcher::Submit(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, EInterverseRequestPriority Priority, const UObject* Owner)
+{
+    const int32 Lane = FMath::Clamp(static_cast<int32>(Priority), 0, NumLanes - 1);
+
+    FQueuedRequest Queued;
+    Queued.Request = Request;
+    Queued.EnqueueTime = FPlatformTime::Seconds();
+    Queued.Owner = Owner;
+    Lanes[Lane].Enqueue(MoveTemp(Queued));
+    LaneDepth[Lane]++;
+
+    UpdateQueueStats();
+    PumpQueue();
+}
+
+void FInterverseHttpDispatcher::ReleaseOwner(const UObject* Owner)
+{
+    if (!Owner)
+    {
+        return;
+    }
+
+    TArray<FQueuedRequest> ToStart;
+    TArray<FQueuedRequest> ToFail;
+    for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+    {
+        // TQueue has no removal, so rotate the lane through a temporary
+        TArray<FQueuedRequest> Kept;
+        FQueuedRequest Queued;
+        while (Lanes[Lane].Dequeue(Queued))
+        {
+            if (Queued.Owner != Owner)
+            {
+                Kept.Add(MoveTemp(Queued));
+            }
+            else if (Queued.Request->GetVerb() == TEXT("GET"))
+            {
+                ToFail.Add(MoveTemp(Queued));
+            }
+            else
+            {
+                ToStart.Add(MoveTemp(Queued));
+            }
+        }
+
+        LaneDepth[Lane] = Kept.Num();
+        for (FQueuedRequest& Entry : Kept)
+        {
+            Lanes[Lane].Enqueue(MoveTemp(Entry));
+        }
+    }
+    UpdateQueueStats();
+
+    // Writes such as the final transaction batch go out now, past the concurrency limit
+    for (FQueuedRequest& Queued : ToStart)
+    {
+        StartRequest(MoveTemp(Queued));
+    }
+    for (const FQueuedRequest& Queued : ToFail)
+    {
+        FailQueued(Queued);
+    }
+}
+
+void FInterverseHttpDispatcher::FailQueued(const FQueuedRequest& Queued)
+{
+    // Never started, so there is no response; callers see an ordinary failed request
+    Queued.Request->OnProcessRequestComplete().ExecuteIfBound(Queued.Request, nullptr, false);
+}
+
+int32 FInterverseHttpDispatcher::GetQueueDepth() const
+{
+    return LaneDepth[0] + LaneDepth[1] + LaneDepth[2];
+}
+
+void FInterverseHttpDispatcher::PumpQueue()
+{
+    while (ActiveRequests.Num() < MaxInFlight)
+    {
+        FQueuedRequest Queued;
+        bool bFound = false;
+
+        // Always drain the highest-priority lane first
+        for (int32 Lane = 0; Lane < NumLanes && !bFound; ++Lane)
+        {
+            if (Lanes[Lane].Dequeue(Queued))
+            {
+                LaneDepth[Lane]--;
+                bFound = true;
+            }
+        }
+
+        if (!bFound)
+        {
+            break;
+        }
+
+        StartRequest(MoveTemp(Queued));
+    }
+
+    UpdateQueueStats();
+}
+
+void FInterverseHttpDispatcher::StartRequest(FQueuedRequest&& Queued)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    TotalQueueWaitMs += (StartTime - Queued.EnqueueTime) * 1000.0;
+    StartedCount++;
+    Stats.AverageQueueWaitMs = static_cast<float>(TotalQueueWaitMs / StartedCount);
+
+    TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request = Queued.Request;
+
+    // Chain our bookkeeping in front of the caller's completion handler
+    FHttpRequestCompleteDelegate CallerDelegate = Request->OnProcessRequestComplete();
+    TWeakPtr<FInterverseHttpDispatcher> WeakThis = AsShared();
+    Request->OnProcessRequestComplete().BindLambda(
+        [WeakThis, CallerDelegate, StartTime](FHttpRequestPtr FinishedRequest, FHttpResponsePtr Response, bool bSucceeded)
+        {
+            if (TSharedPtr<FInterverseHttpDispatcher> This = WeakThis.Pin())
+            {
+                This->OnRequestFinished(FinishedRequest, bSucceeded, StartTime);
+            }
+            CallerDelegate.ExecuteIfBound(FinishedRequest, Response, bSucceeded);
+        });
+
+    ActiveRequests.Add(Request);
+    Stats.InFlight = ActiveRequests.Num();
+
+    if (!Request->ProcessRequest())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to start request to %s"), *Request->GetURL());
+        ActiveRequests.Remove(Request);
+        Stats.InFlight = ActiveRequests.Num();
+        Stats.Failed++;
+    }
+}
+
+void FInterverseHttpDispatcher::OnRequestFinished(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request, bool bSucceeded, double StartTime)
+{
+    if (ActiveRequests.Remove(Request) == 0)
+    {
+        return;
+    }
+
+    const double LatencyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    TotalLatencyMs += LatencyMs;
+    Stats.LastLatencyMs = static_cast<float>(LatencyMs);
+
+    if (bSucceeded)
+    {
+        Stats.Completed++;
+    }
+    else
+    {
+        Stats.Failed++;
+    }
+
+    const int32 Finished = Stats.Completed + Stats.Failed;
+    Stats.AverageLatencyMs = static_cast<float>(TotalLatencyMs / FMath::Max(Finished, 1));
+    Stats.InFlight = ActiveRequests.Num();
+
+    PumpQueue();
+}
+
+void FInterverseHttpDispatcher::UpdateQueueStats()
+{
+    Stats.QueuedHigh = LaneDepth[static_cast<int32>(EInterverseRequestPriority::High)];
+    Stats.QueuedNormal = LaneDepth[static_cast<int32>(EInterverseRequestPriority::Normal)];
+    Stats.QueuedLow = LaneDepth[static_cast<int32>(EInterverseRequestPriority::Low)];
+    Stats.PeakQueueDepth = FMath::Max(Stats.PeakQueueDepth, GetQueueDepth());
+    Stats.InFlight = ActiveRequests.Num();
+}
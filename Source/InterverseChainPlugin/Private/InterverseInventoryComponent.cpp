@@ -1,4 +1,80 @@
 #include "InterverseInventoryComponent.h"
+#include "InterverseAssetCacheSave.h"
+#include "Kismet/GameplayStatics.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Misc/SecureHash.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+    FString GetCacheSlotName(const FString& WalletAddress)
+    {
+        return FString::Printf(TEXT("InterverseAssets_%s"), *FMD5::HashAnsiString(*WalletAddress));
+    }
+
+    bool AssetsEqual(const FInterverseAsset& A, const FInterverseAsset& B)
+    {
+        return A.AssetId == B.AssetId &&
+            A.Owner == B.Owner &&
+            A.OwnerGlobalID == B.OwnerGlobalID &&
+            A.AssetType == B.AssetType &&
+            A.Category == B.Category &&
+            A.Rarity == B.Rarity &&
+            A.Metadata.OrderIndependentCompareEqual(B.Metadata);
+    }
+
+    // Length-prefixed UTF-8 so adjacent fields can't run into each other
+    void UpdateHash(FSHA1& Sha, const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        const int32 Length = Utf8.Length();
+        Sha.Update(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+        Sha.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+    }
+
+    bool LessCaseSensitive(const FString& A, const FString& B)
+    {
+        return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+    }
+
+    // Order-independent: assets and metadata keys are hashed in sorted order. SHA-1 of the exact
+    // bytes, so ids differing only in case or colliding in a 32-bit hash still count as changes.
+    FString HashAssets(TArray<const FInterverseAsset*> Assets)
+    {
+        Assets.Sort([](const FInterverseAsset& A, const FInterverseAsset& B) { return LessCaseSensitive(A.AssetId, B.AssetId); });
+
+        FSHA1 Sha;
+        for (const FInterverseAsset* Asset : Assets)
+        {
+            UpdateHash(Sha, Asset->AssetId);
+            UpdateHash(Sha, Asset->Owner);
+            UpdateHash(Sha, Asset->OwnerGlobalID);
+
+            const uint8 Enums[] = { static_cast<uint8>(Asset->AssetType), static_cast<uint8>(Asset->Category), static_cast<uint8>(Asset->Rarity) };
+            Sha.Update(Enums, sizeof(Enums));
+
+            TArray<FString> Keys;
+            Asset->Metadata.GetKeys(Keys);
+            Keys.Sort(&LessCaseSensitive);
+
+            const int32 NumKeys = Keys.Num();
+            Sha.Update(reinterpret_cast<const uint8*>(&NumKeys), sizeof(NumKeys));
+            for (const FString& Key : Keys)
+            {
+                UpdateHash(Sha, Key);
+                UpdateHash(Sha, Asset->Metadata[Key]);
+            }
+        }
+        Sha.Final();
+
+        FSHAHash Hash;
+        Sha.GetHash(Hash.Hash);
+        return Hash.ToString();
+    }
+}
 
 UInterverseInventoryComponent::UInterverseInventoryComponent()
 {
@@ -7,141 +83,625 @@ UInterverseInventoryComponent::UInterverseInventoryComponent()
 
 bool UInterverseInventoryComponent::AddItem(const FInterverseAsset& Asset, const FString& PlayerGlobalID)
 {
-    FInterverseInventoryItem NewItem;
-    NewItem.Asset = Asset;
-    NewItem.OwnerGlobalID = PlayerGlobalID;
-    NewItem.IsEquipped = false;
-    NewItem.Slot = Items.Num();
-    
-    Items.Add(NewItem);
-    OnInventoryUpdated.Broadcast(Items);
-    return true;
+    return AddItemInternal(Asset, PlayerGlobalID);
 }
 
 bool UInterverseInventoryComponent::RemoveItem(const FString& AssetId)
 {
-    int32 Index = Items.IndexOfByPredicate([AssetId](const FInterverseInventoryItem& Item) {
-        return Item.Asset.AssetId == AssetId;
-    });
-
-    if (Index != INDEX_NONE)
+    const int32 Index = FindItemIndex(AssetId);
+    if (Index == INDEX_NONE)
     {
-        Items.RemoveAt(Index);
-        OnInventoryUpdated.Broadcast(Items);
-        return true;
+        return false;
     }
-    return false;
-}
 
-bool UInterverseInventoryComponent::EquipItem(const FString& AssetId)
-{
-    for (FInterverseInventoryItem& Item : Items)
+    RecordChange(EInterverseInventoryChangeKind::Removed, Items[Index]);
+
+    UnindexItem(Index);
+    Items.RemoveAt(Index);
+    IndexedItemCount = Items.Num();
+
+    // Keep Blueprint-visible order; everything after the gap moved down one slot, which is
+    // plain integer fix-ups rather than rehashing any keys
+    for (TPair<FString, int32>& Pair : AssetIndex)
+    {
+        if (Pair.Value > Index)
+        {
+            --Pair.Value;
+        }
+    }
+    auto ShiftDown = [Index](TArray<int32>& Indices)
     {
-        if (Item.Asset.AssetId == AssetId)
+        for (int32& Entry : Indices)
         {
-            // Unequip any other items of the same category
-            for (FInterverseInventoryItem& OtherItem : Items)
+            if (Entry > Index)
             {
-                if (OtherItem.Asset.Category == Item.Asset.Category)
-                {
-                    OtherItem.IsEquipped = false;
-                }
+                --Entry;
             }
-            
-            Item.IsEquipped = true;
-            OnInventoryUpdated.Broadcast(Items);
-            return true;
         }
+    };
+    for (TPair<FString, TArray<int32>>& Pair : OwnerIndex)
+    {
+        ShiftDown(Pair.Value);
+    }
+    for (TPair<EInterverseItemCategory, TArray<int32>>& Pair : CategoryIndex)
+    {
+        ShiftDown(Pair.Value);
     }
-    return false;
+
+    FlushChanges();
+    return true;
 }
 
-TArray<FInterverseInventoryItem> UInterverseInventoryComponent::GetItemsByCategory(EInterverseItemCategory Category) const
+bool UInterverseInventoryComponent::EquipItem(const FString& AssetId)
 {
-    TArray<FInterverseInventoryItem> FilteredItems;
-    for (const FInterverseInventoryItem& Item : Items)
+    const int32 Index = FindItemIndex(AssetId);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Unequip any other items of the same category
+    for (int32 OtherIndex : GetCategoryItemIndices(Items[Index].Asset.Category))
     {
-        if (Item.Asset.Category == Category)
+        if (OtherIndex != Index && Items[OtherIndex].IsEquipped)
         {
-            FilteredItems.Add(Item);
+            Items[OtherIndex].IsEquipped = false;
+            RecordChange(EInterverseInventoryChangeKind::Changed, Items[OtherIndex]);
         }
     }
+
+    if (!Items[Index].IsEquipped)
+    {
+        Items[Index].IsEquipped = true;
+        RecordChange(EInterverseInventoryChangeKind::Changed, Items[Index]);
+    }
+
+    FlushChanges();
+    return true;
+}
+
+TArray<FInterverseInventoryItem> UInterverseInventoryComponent::GetItemsByCategory(EInterverseItemCategory Category) const
+{
+    TArray<FInterverseInventoryItem> FilteredItems;
+    FillItemsByCategory(Category, FilteredItems);
     return FilteredItems;
 }
 
 TArray<FInterverseInventoryItem> UInterverseInventoryComponent::GetPlayerItems(const FString& PlayerGlobalID) const
 {
     TArray<FInterverseInventoryItem> PlayerItems;
-    for (const FInterverseInventoryItem& Item : Items)
+    FillPlayerItems(PlayerGlobalID, PlayerItems);
+    return PlayerItems;
+}
+
+void UInterverseInventoryComponent::FillPlayerItems(const FString& PlayerGlobalID, TArray<FInterverseInventoryItem>& OutItems) const
+{
+    CopyItems(GetPlayerItemIndices(PlayerGlobalID), OutItems);
+}
+
+void UInterverseInventoryComponent::FillItemsByCategory(EInterverseItemCategory Category, TArray<FInterverseInventoryItem>& OutItems) const
+{
+    CopyItems(GetCategoryItemIndices(Category), OutItems);
+}
+
+void UInterverseInventoryComponent::CopyItems(TConstArrayView<int32> Indices, TArray<FInterverseInventoryItem>& OutItems) const
+{
+    // Assigning over the elements already there lets their strings and maps keep their buffers
+    OutItems.SetNum(Indices.Num(), EAllowShrinking::No);
+    for (int32 Position = 0; Position < Indices.Num(); ++Position)
+    {
+        OutItems[Position] = Items[Indices[Position]];
+    }
+}
+
+TConstArrayView<int32> UInterverseInventoryComponent::GetPlayerItemIndices(const FString& PlayerGlobalID) const
+{
+    EnsureIndices();
+
+    const TArray<int32>* Indices = OwnerIndex.Find(PlayerGlobalID);
+    if (Indices && !IsIndexListCurrent(*Indices, [&PlayerGlobalID](const FInterverseInventoryItem& Item) { return Item.OwnerGlobalID == PlayerGlobalID; }))
+    {
+        RebuildIndicesInternal();
+        Indices = OwnerIndex.Find(PlayerGlobalID);
+    }
+    return Indices ? TConstArrayView<int32>(*Indices) : TConstArrayView<int32>();
+}
+
+TConstArrayView<int32> UInterverseInventoryComponent::GetCategoryItemIndices(EInterverseItemCategory Category) const
+{
+    EnsureIndices();
+
+    const TArray<int32>* Indices = CategoryIndex.Find(Category);
+    if (Indices && !IsIndexListCurrent(*Indices, [Category](const FInterverseInventoryItem& Item) { return Item.Asset.Category == Category; }))
+    {
+        RebuildIndicesInternal();
+        Indices = CategoryIndex.Find(Category);
+    }
+    return Indices ? TConstArrayView<int32>(*Indices) : TConstArrayView<int32>();
+}
+
+const FInterverseInventoryItem* UInterverseInventoryComponent::FindItem(const FString& AssetId) const
+{
+    const int32 Index = FindItemIndex(AssetId);
+    return Index != INDEX_NONE ? &Items[Index] : nullptr;
+}
+
+void UInterverseInventoryComponent::GetPlayerItemPointers(const FString& PlayerGlobalID, TArray<const FInterverseInventoryItem*>& OutItems) const
+{
+    const TConstArrayView<int32> Indices = GetPlayerItemIndices(PlayerGlobalID);
+    OutItems.Reset(Indices.Num());
+    for (int32 Index : Indices)
+    {
+        OutItems.Add(&Items[Index]);
+    }
+}
+
+bool UInterverseInventoryComponent::AddItemToPlayerInventory(const FInterverseAsset& Asset, const FString& PlayerGlobalID)
+{
+    return AddItemInternal(Asset, PlayerGlobalID);
+}
+
+TArray<FInterverseInventoryItem> UInterverseInventoryComponent::GetPlayerInventory(const FString& PlayerGlobalID) const
+{
+    return GetPlayerItems(PlayerGlobalID);
+}
+
+bool UInterverseInventoryComponent::TransferItemBetweenPlayers(const FString& AssetId, const FString& FromPlayerID, const FString& ToPlayerID)
+{
+    const int32 Index = FindItemIndex(AssetId);
+    if (Index == INDEX_NONE || Items[Index].OwnerGlobalID != FromPlayerID)
+    {
+        return false;
+    }
+
+    UnindexItem(Index);
+    Items[Index].OwnerGlobalID = ToPlayerID;
+    IndexItem(Index);
+
+    RecordChange(EInterverseInventoryChangeKind::Changed, Items[Index]);
+    FlushChanges();
+    return true;
+}
+
+bool UInterverseInventoryComponent::AddItem(const FInterverseAsset& Asset)
+{
+    return AddItemInternal(Asset, FString());
+}
+
+bool UInterverseInventoryComponent::HasItem(const FString& AssetId) const
+{
+    return FindItemIndex(AssetId) != INDEX_NONE;
+}
+
+int32 UInterverseInventoryComponent::GetInventorySize() const
+{
+    return Items.Num();
+}
+
+void UInterverseInventoryComponent::RebuildIndices()
+{
+    RebuildIndicesInternal();
+}
+
+void UInterverseInventoryComponent::BeginInventoryBatch()
+{
+    ++BatchDepth;
+}
+
+void UInterverseInventoryComponent::EndInventoryBatch()
+{
+    if (BatchDepth == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("EndInventoryBatch called without a matching BeginInventoryBatch"));
+        return;
+    }
+
+    --BatchDepth;
+    FlushChanges();
+}
+
+void UInterverseInventoryComponent::RecordChange(EInterverseInventoryChangeKind Kind, const FInterverseInventoryItem& Item)
+{
+    const FString& AssetId = Item.Asset.AssetId;
+    FInterverseInventoryChange* Existing = PendingChanges.Find(AssetId);
+    if (!Existing)
+    {
+        FInterverseInventoryChange& Change = PendingChanges.Add(AssetId);
+        Change.Kind = Kind;
+        Change.Item = Item;
+        PendingChangeOrder.Add(AssetId);
+        return;
+    }
+
+    // Fold this mutation into the one already pending for the same asset
+    const EInterverseInventoryChangeKind Previous = Existing->Kind;
+    if (Kind == EInterverseInventoryChangeKind::Removed && Previous == EInterverseInventoryChangeKind::Added)
+    {
+        // Added and removed within one batch: listeners never need to hear about it
+        PendingChanges.Remove(AssetId);
+        return;
+    }
+
+    if (Kind == EInterverseInventoryChangeKind::Added && Previous == EInterverseInventoryChangeKind::Removed)
+    {
+        Existing->Kind = EInterverseInventoryChangeKind::Changed;
+    }
+    else if (Kind != EInterverseInventoryChangeKind::Changed)
+    {
+        Existing->Kind = Kind;
+    }
+    Existing->Item = Item;
+}
+
+void UInterverseInventoryComponent::FlushChanges()
+{
+    if (BatchDepth > 0)
+    {
+        return;
+    }
+
+    if (PendingChanges.Num() == 0)
     {
-        if (Item.OwnerGlobalID == PlayerGlobalID)
+        PendingChangeOrder.Reset();
+        return;
+    }
+
+    TArray<FInterverseInventoryChange> Changes;
+    Changes.Reserve(PendingChanges.Num());
+    for (const FString& AssetId : PendingChangeOrder)
+    {
+        FInterverseInventoryChange Change;
+        if (PendingChanges.RemoveAndCopyValue(AssetId, Change))
         {
-            PlayerItems.Add(Item);
+            Changes.Add(MoveTemp(Change));
         }
     }
-    return PlayerItems;
+    PendingChanges.Reset();
+    PendingChangeOrder.Reset();
+
+    OnInventoryChanged.Broadcast(Changes);
+
+    // The full-array event is only worth building when someone still listens to it
+    if (OnInventoryUpdated.IsBound())
+    {
+        OnInventoryUpdated.Broadcast(Items);
+    }
 }
 
-bool UInterverseInventoryComponent::AddItemToPlayerInventory(const FInterverseAsset& Asset, const FString& PlayerGlobalID)
+bool UInterverseInventoryComponent::AddItemInternal(const FInterverseAsset& Asset, const FString& PlayerGlobalID)
 {
     FInterverseInventoryItem NewItem;
     NewItem.Asset = Asset;
     NewItem.OwnerGlobalID = PlayerGlobalID;
     NewItem.IsEquipped = false;
     NewItem.Slot = Items.Num();
+
+    return AddItemInternal(MoveTemp(NewItem));
+}
+
+bool UInterverseInventoryComponent::AddItemInternal(FInterverseInventoryItem&& NewItem)
+{
+    // Asset IDs are unique on chain, so a second copy would only shadow the first
+    if (FindItemIndex(NewItem.Asset.AssetId) != INDEX_NONE)
+    {
+        return false;
+    }
     
-    Items.Add(NewItem);
-    OnInventoryUpdated.Broadcast(Items);
+    const int32 Index = Items.Add(MoveTemp(NewItem));
+    IndexItem(Index);
+    IndexedItemCount = Items.Num();
+
+    RecordChange(EInterverseInventoryChangeKind::Added, Items[Index]);
+    FlushChanges();
     return true;
 }
 
-TArray<FInterverseInventoryItem> UInterverseInventoryComponent::GetPlayerInventory(const FString& PlayerGlobalID) const
+void UInterverseInventoryComponent::UpdateItemAsset(int32 Index, const FInterverseAsset& Asset)
 {
-    TArray<FInterverseInventoryItem> PlayerItems;
+    // Category and owner feed the indices, so take the item out and put it back
+    UnindexItem(Index);
+    Items[Index].Asset = Asset;
+    IndexItem(Index);
+
+    RecordChange(EInterverseInventoryChangeKind::Changed, Items[Index]);
+}
+
+void UInterverseInventoryComponent::LoadCachedInventory(const FString& WalletAddress)
+{
+    if (WalletAddress.IsEmpty())
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const FString SlotName = GetCacheSlotName(WalletAddress);
+
+    // Disk access off the game thread; the save object itself must be created on it
+    TWeakObjectPtr<UInterverseInventoryComponent> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, WalletAddress, SlotName, StartTime]()
+    {
+        TArray<uint8> Bytes;
+        ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+        if (SaveSystem && SaveSystem->DoesSaveGameExist(*SlotName, 0))
+        {
+            SaveSystem->LoadGame(false, *SlotName, 0, Bytes);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, WalletAddress, StartTime, Bytes = MoveTemp(Bytes)]()
+        {
+            if (UInterverseInventoryComponent* This = WeakThis.Get())
+            {
+                This->ApplyCachedBytes(WalletAddress, Bytes, StartTime);
+            }
+        });
+    });
+}
+
+void UInterverseInventoryComponent::ApplyCachedBytes(const FString& WalletAddress, const TArray<uint8>& Bytes, double StartTime)
+{
+    UInterverseAssetCacheSave* Cache = Bytes.Num() > 0
+        ? Cast<UInterverseAssetCacheSave>(UGameplayStatics::LoadGameFromMemory(Bytes))
+        : nullptr;
+
+    if (!Cache || Cache->Version != UInterverseAssetCacheSave::CurrentVersion || Cache->WalletAddress != WalletAddress)
+    {
+        if (Bytes.Num() > 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Ignoring stale or unreadable asset cache for %s"), *WalletAddress);
+        }
+        OnInventoryCacheLoaded.Broadcast(false);
+        return;
+    }
+
+    // A reconcile or save that beat the disk read already left the inventory fresher than the file
+    if (CachedContentHashes.Contains(WalletAddress))
+    {
+        OnInventoryCacheLoaded.Broadcast(false);
+        return;
+    }
+
+    int32 Loaded = 0;
+    {
+        FInterverseInventoryBatchScope Batch(this);
+        Items.Reserve(Items.Num() + Cache->Items.Num());
+        for (FInterverseInventoryItem& Item : Cache->Items)
+        {
+            if (AddItemInternal(MoveTemp(Item)))
+            {
+                ++Loaded;
+            }
+        }
+    }
+
+    CachedContentHashes.Add(WalletAddress, Cache->ContentHash);
+
+    CacheStats.LoadMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    CacheStats.BytesRead = Bytes.Num();
+    CacheStats.ItemsLoaded = Loaded;
+    UE_LOG(LogTemp, Log, TEXT("Loaded %d cached assets for %s in %.2f ms (%d bytes)"), Loaded, *WalletAddress, CacheStats.LoadMs, Bytes.Num());
+
+    OnInventoryCacheLoaded.Broadcast(true);
+}
+
+void UInterverseInventoryComponent::SaveInventoryCache(const FString& WalletAddress)
+{
+    if (WalletAddress.IsEmpty())
+    {
+        return;
+    }
+
+    UInterverseAssetCacheSave* Cache = NewObject<UInterverseAssetCacheSave>();
+    Cache->Version = UInterverseAssetCacheSave::CurrentVersion;
+    Cache->WalletAddress = WalletAddress;
+    Cache->SavedAt = FDateTime::UtcNow();
+
+    TArray<const FInterverseAsset*> Assets;
     for (const FInterverseInventoryItem& Item : Items)
     {
-        if (Item.OwnerGlobalID == PlayerGlobalID)
+        if (Item.Asset.Owner == WalletAddress)
         {
-            PlayerItems.Add(Item);
+            Cache->Items.Add(Item);
+            Assets.Add(&Item.Asset);
         }
     }
-    return PlayerItems;
+    Cache->ContentHash = HashAssets(MoveTemp(Assets));
+    CachedContentHashes.Add(WalletAddress, Cache->ContentHash);
+
+    TSharedRef<TArray<uint8>> Bytes = MakeShared<TArray<uint8>>();
+    if (!UGameplayStatics::SaveGameToMemory(Cache, *Bytes))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to serialize asset cache for %s"), *WalletAddress);
+        return;
+    }
+    CacheStats.BytesWritten = Bytes->Num();
+
+    const FString SlotName = GetCacheSlotName(WalletAddress);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Bytes, SlotName]()
+    {
+        ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+        if (!SaveSystem || !SaveSystem->SaveGame(false, *SlotName, 0, *Bytes))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to write asset cache slot %s"), *SlotName);
+        }
+    });
 }
 
-bool UInterverseInventoryComponent::TransferItemBetweenPlayers(const FString& AssetId, const FString& FromPlayerID, const FString& ToPlayerID)
+void UInterverseInventoryComponent::ReconcileWithChain(UInterverseChainComponent* ChainComponent, const FString& WalletAddress)
+{
+    if (!ChainComponent || WalletAddress.IsEmpty())
+    {
+        return;
+    }
+
+    TWeakObjectPtr<UInterverseInventoryComponent> WeakThis(this);
+    ChainComponent->GetPlayerAssets(WalletAddress, [WeakThis, WalletAddress](bool bSuccess, const TArray<FInterverseAsset>& Assets)
+    {
+        UInterverseInventoryComponent* This = WeakThis.Get();
+        if (This && bSuccess)
+        {
+            This->ApplyChainAssets(WalletAddress, Assets);
+        }
+    });
+}
+
+void UInterverseInventoryComponent::ApplyChainAssets(const FString& WalletAddress, const TArray<FInterverseAsset>& Assets)
 {
-    for (FInterverseInventoryItem& Item : Items)
+    TArray<const FInterverseAsset*> AssetPointers;
+    AssetPointers.Reserve(Assets.Num());
+    for (const FInterverseAsset& Asset : Assets)
+    {
+        AssetPointers.Add(&Asset);
+    }
+
+    const FString ChainHash = HashAssets(MoveTemp(AssetPointers));
+    const FString* CachedHash = CachedContentHashes.Find(WalletAddress);
+
+    CacheStats.ReconcileAdded = 0;
+    CacheStats.ReconcileRemoved = 0;
+    CacheStats.ReconcileChanged = 0;
+    CacheStats.bCacheWasCurrent = CachedHash && *CachedHash == ChainHash;
+    if (CacheStats.bCacheWasCurrent)
+    {
+        return;
+    }
+
+    TMap<FString, const FInterverseAsset*> ChainAssets;
+    ChainAssets.Reserve(Assets.Num());
+    for (const FInterverseAsset& Asset : Assets)
     {
-        if (Item.Asset.AssetId == AssetId && Item.OwnerGlobalID == FromPlayerID)
+        ChainAssets.Add(Asset.AssetId, &Asset);
+    }
+
+    {
+        FInterverseInventoryBatchScope Batch(this);
+
+        TArray<FString> Gone;
+        for (int32 Index = 0; Index < Items.Num(); ++Index)
+        {
+            if (Items[Index].Asset.Owner != WalletAddress)
+            {
+                continue;
+            }
+
+            const FInterverseAsset* ChainAsset = nullptr;
+            if (!ChainAssets.RemoveAndCopyValue(Items[Index].Asset.AssetId, ChainAsset))
+            {
+                Gone.Add(Items[Index].Asset.AssetId);
+            }
+            else if (!AssetsEqual(Items[Index].Asset, *ChainAsset))
+            {
+                UpdateItemAsset(Index, *ChainAsset);
+                ++CacheStats.ReconcileChanged;
+            }
+        }
+
+        for (const FString& AssetId : Gone)
+        {
+            if (RemoveItem(AssetId))
+            {
+                ++CacheStats.ReconcileRemoved;
+            }
+        }
+
+        // Whatever is left is new to this inventory
+        for (const FInterverseAsset& Asset : Assets)
         {
-            Item.OwnerGlobalID = ToPlayerID;
-            OnInventoryUpdated.Broadcast(Items);
-            return true;
+            if (ChainAssets.Contains(Asset.AssetId) && AddItemInternal(Asset, Asset.OwnerGlobalID))
+            {
+                ++CacheStats.ReconcileAdded;
+            }
         }
     }
-    return false;
+
+    SaveInventoryCache(WalletAddress);
 }
 
-bool UInterverseInventoryComponent::AddItem(const FInterverseAsset& Asset)
+int32 UInterverseInventoryComponent::FindItemIndex(const FString& AssetId) const
 {
-    FInterverseInventoryItem NewItem;
-    NewItem.Asset = Asset;
-    NewItem.IsEquipped = false;
-    NewItem.Slot = Items.Num();
-    
-    Items.Add(NewItem);
-    OnInventoryUpdated.Broadcast(Items);
-    return true;
+    EnsureIndices();
+
+    const int32* Index = AssetIndex.Find(AssetId);
+    if (Index && (!Items.IsValidIndex(*Index) || Items[*Index].Asset.AssetId != AssetId))
+    {
+        // Items was edited in place from Blueprint without changing its size
+        RebuildIndicesInternal();
+        Index = AssetIndex.Find(AssetId);
+    }
+    return Index ? *Index : INDEX_NONE;
 }
 
-bool UInterverseInventoryComponent::HasItem(const FString& AssetId) const
+void UInterverseInventoryComponent::IndexItem(int32 Index) const
 {
-    return Items.ContainsByPredicate([AssetId](const FInterverseInventoryItem& Item) {
-        return Item.Asset.AssetId == AssetId;
-    });
+    const FInterverseInventoryItem& Item = Items[Index];
+    AssetIndex.Add(Item.Asset.AssetId, Index);
+
+    // Usually an append; re-indexing an edited item puts it back in its place
+    TArray<int32>& Owned = OwnerIndex.FindOrAdd(Item.OwnerGlobalID);
+    Owned.Insert(Index, Algo::LowerBound(Owned, Index));
+    TArray<int32>& InCategory = CategoryIndex.FindOrAdd(Item.Asset.Category);
+    InCategory.Insert(Index, Algo::LowerBound(InCategory, Index));
 }
 
-int32 UInterverseInventoryComponent::GetInventorySize() const
+void UInterverseInventoryComponent::UnindexItem(int32 Index) const
 {
-    return Items.Num();
-}
\ No newline at end of file
+    const FInterverseInventoryItem& Item = Items[Index];
+    AssetIndex.Remove(Item.Asset.AssetId);
+
+    if (TArray<int32>* Owned = OwnerIndex.Find(Item.OwnerGlobalID))
+    {
+        const int32 Position = Algo::BinarySearch(*Owned, Index);
+        if (Position != INDEX_NONE)
+        {
+            Owned->RemoveAt(Position, 1, EAllowShrinking::No);
+        }
+        if (Owned->Num() == 0)
+        {
+            OwnerIndex.Remove(Item.OwnerGlobalID);
+        }
+    }
+
+    if (TArray<int32>* InCategory = CategoryIndex.Find(Item.Asset.Category))
+    {
+        const int32 Position = Algo::BinarySearch(*InCategory, Index);
+        if (Position != INDEX_NONE)
+        {
+            InCategory->RemoveAt(Position, 1, EAllowShrinking::No);
+        }
+    }
+}
+
+void UInterverseInventoryComponent::EnsureIndices() const
+{
+    // Items is Blueprint-writable; a size mismatch means it was edited behind our back
+    if (IndexedItemCount != Items.Num())
+    {
+        RebuildIndicesInternal();
+    }
+}
+
+bool UInterverseInventoryComponent::IsIndexListCurrent(const TArray<int32>& Indices, TFunctionRef<bool(const FInterverseInventoryItem&)> Matches) const
+{
+    // Callers walk the whole list anyway, so checking it first costs no more than using it
+    for (int32 Index : Indices)
+    {
+        if (!Items.IsValidIndex(Index) || !Matches(Items[Index]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UInterverseInventoryComponent::RebuildIndicesInternal() const
+{
+    AssetIndex.Reset();
+    OwnerIndex.Reset();
+    CategoryIndex.Reset();
+
+    AssetIndex.Reserve(Items.Num());
+    for (int32 Index = 0; Index < Items.Num(); ++Index)
+    {
+        IndexItem(Index);
+    }
+    IndexedItemCount = Items.Num();
+}
@@ -0,0 +1,209 @@
+#include "InterverseJsonListReader.h"
+#include "InterverseCompatibility.h"
+#include "Json.h"
+#include "Algo/AnyOf.h"
+
+namespace
+{
+    // Builds the value starting at the token the reader just returned
+    TSharedPtr<FJsonValue> ReadValue(TJsonReader<>& Reader, EJsonNotation Notation)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::String:
+            return MakeShared<FJsonValueString>(Reader.GetValueAsString());
+
+        case EJsonNotation::Number:
+            return MakeShared<FJsonValueNumber>(Reader.GetValueAsNumber());
+
+        case EJsonNotation::Boolean:
+            return MakeShared<FJsonValueBoolean>(Reader.GetValueAsBoolean());
+
+        case EJsonNotation::Null:
+            return MakeShared<FJsonValueNull>();
+
+        case EJsonNotation::ObjectStart:
+        {
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            EJsonNotation Next;
+            while (Reader.ReadNext(Next))
+            {
+                if (Next == EJsonNotation::ObjectEnd)
+                {
+                    return MakeShared<FJsonValueObject>(Object);
+                }
+
+                const FString Field = Reader.GetIdentifier();
+                TSharedPtr<FJsonValue> Value = ReadValue(Reader, Next);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Object->SetField(Field, Value);
+            }
+            return nullptr;
+        }
+
+        case EJsonNotation::ArrayStart:
+        {
+            TArray<TSharedPtr<FJsonValue>> Values;
+            EJsonNotation Next;
+            while (Reader.ReadNext(Next))
+            {
+                if (Next == EJsonNotation::ArrayEnd)
+                {
+                    return MakeShared<FJsonValueArray>(Values);
+                }
+
+                TSharedPtr<FJsonValue> Value = ReadValue(Reader, Next);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Values.Add(Value);
+            }
+            return nullptr;
+        }
+
+        default:
+            return nullptr;
+        }
+    }
+}
+
+bool FInterverseJsonListReader::ForEachItem(
+    const FString& Content,
+    TArrayView<const TCHAR* const> ListPaths,
+    TFunctionRef<void(const TSharedPtr<FJsonValue>& Item)> OnItem)
+{
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+
+    // Field names of the containers we are inside, root first
+    TArray<FString> Scope;
+
+    EJsonNotation Notation;
+    while (Reader->ReadNext(Notation))
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+            Scope.Push(Reader->GetIdentifier());
+            break;
+
+        case EJsonNotation::ArrayStart:
+        {
+            FString Path;
+            for (int32 Index = 1; Index < Scope.Num(); ++Index)
+            {
+                Path += Scope[Index];
+                Path += TEXT(".");
+            }
+            Path += Reader->GetIdentifier();
+
+            const bool bIsList = Scope.Num() > 0 && Algo::AnyOf(ListPaths, [&Path](const TCHAR* ListPath)
+            {
+                return Path == ListPath;
+            });
+
+            if (!bIsList)
+            {
+                Scope.Push(Reader->GetIdentifier());
+                break;
+            }
+
+            // Materialise one element at a time; the rest of the document is never read
+            EJsonNotation ItemNotation;
+            while (Reader->ReadNext(ItemNotation))
+            {
+                if (ItemNotation == EJsonNotation::ArrayEnd)
+                {
+                    return true;
+                }
+
+                TSharedPtr<FJsonValue> Item = ReadValue(*Reader, ItemNotation);
+                if (!Item.IsValid())
+                {
+                    return false;
+                }
+                OnItem(Item);
+            }
+            return false;
+        }
+
+        case EJsonNotation::ObjectEnd:
+        case EJsonNotation::ArrayEnd:
+            Scope.Pop(EAllowShrinking::No);
+            break;
+
+        case EJsonNotation::Error:
+            return false;
+
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+bool FInterverseJsonListReader::ReadAssets(const FString& Content, int32 ChunkSize, TFunctionRef<void(TArray<FInterverseAsset>&& Chunk)> OnChunk)
+{
+    ChunkSize = FMath::Max(1, ChunkSize);
+
+    // Nodes answer either with a bare array or with an object wrapping "assets"
+    static const TCHAR* const AssetPaths[] = { TEXT("data"), TEXT("data.assets") };
+
+    TArray<FInterverseAsset> Chunk;
+    Chunk.Reserve(ChunkSize);
+
+    const bool bParsed = ForEachItem(Content, AssetPaths, [&](const TSharedPtr<FJsonValue>& Item)
+    {
+        const TSharedPtr<FJsonObject>* AssetObject;
+        FInterverseAsset Asset;
+        if (Item->TryGetObject(AssetObject) && InterverseCompat::ConvertJsonToAsset(*AssetObject, Asset))
+        {
+            Chunk.Add(MoveTemp(Asset));
+            if (Chunk.Num() >= ChunkSize)
+            {
+                OnChunk(MoveTemp(Chunk));
+                Chunk.Reset(ChunkSize);
+            }
+        }
+    });
+
+    if (bParsed && Chunk.Num() > 0)
+    {
+        OnChunk(MoveTemp(Chunk));
+    }
+    return bParsed;
+}
+
+bool FInterverseJsonListReader::ReadTransactions(const FString& Content, int32 ChunkSize, TFunctionRef<void(TArray<FString>&& Chunk)> OnChunk)
+{
+    ChunkSize = FMath::Max(1, ChunkSize);
+
+    static const TCHAR* const TransactionPaths[] = { TEXT("transactions") };
+
+    TArray<FString> Chunk;
+    Chunk.Reserve(ChunkSize);
+
+    const bool bParsed = ForEachItem(Content, TransactionPaths, [&](const TSharedPtr<FJsonValue>& Item)
+    {
+        FString Transaction;
+        if (Item->TryGetString(Transaction))
+        {
+            Chunk.Add(MoveTemp(Transaction));
+            if (Chunk.Num() >= ChunkSize)
+            {
+                OnChunk(MoveTemp(Chunk));
+                Chunk.Reset(ChunkSize);
+            }
+        }
+    });
+
+    if (bParsed && Chunk.Num() > 0)
+    {
+        OnChunk(MoveTemp(Chunk));
+    }
+    return bParsed;
+}
@@ -0,0 +1,214 @@
+#include "InterverseLedgerMirror.h"
+#include "InterverseJsonListReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Json.h"
+
+namespace
+{
+    constexpr uint32 LedgerFileMagic = 0x4D474C49; // "ILGM"
+    constexpr int32 LedgerFileVersion = 1;
+
+    FString WriteCondensed(const TSharedPtr<FJsonValue>& Value)
+    {
+        FString Result;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Result);
+        FJsonSerializer::Serialize(Value, FString(), Writer);
+        return Result;
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FInterverseLedgerBlock& Block)
+{
+    Ar << Block.Index;
+    Ar << Block.Hash;
+    Ar << Block.PreviousHash;
+    Ar << Block.Timestamp;
+    Ar << Block.Transactions;
+    return Ar;
+}
+
+const FInterverseLedgerBlock* FInterverseLedgerMirror::FindBlock(int64 Index) const
+{
+    if (Blocks.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    // Blocks are contiguous, so the index is an offset from the first one
+    const int64 Offset = Index - Blocks[0].Index;
+    return Offset >= 0 && Offset < Blocks.Num() ? &Blocks[static_cast<int32>(Offset)] : nullptr;
+}
+
+void FInterverseLedgerMirror::GetBlocksSince(int64 Index, int32 MaxBlocks, TArray<FInterverseLedgerBlock>& OutBlocks) const
+{
+    OutBlocks.Reset();
+    if (Blocks.Num() == 0 || MaxBlocks <= 0)
+    {
+        return;
+    }
+
+    const int64 First = FMath::Max<int64>(0, Index - Blocks[0].Index);
+    const int64 Last = FMath::Min<int64>(Blocks.Num(), First + MaxBlocks);
+    for (int64 Offset = First; Offset < Last; ++Offset)
+    {
+        OutBlocks.Add(Blocks[Offset]);
+    }
+}
+
+int32 FInterverseLedgerMirror::ApplyBlocks(TArray<FInterverseLedgerBlock>&& NewBlocks)
+{
+    int32 Taken = 0;
+    for (FInterverseLedgerBlock& Block : NewBlocks)
+    {
+        if (Blocks.Num() > 0 && Block.Index < Blocks[0].Index)
+        {
+            continue;
+        }
+
+        // Nodes that ignore ?from= resend what we have; keep ours unless the node rewrote it
+        if (const FInterverseLedgerBlock* Existing = FindBlock(Block.Index))
+        {
+            if (Existing->Hash == Block.Hash)
+            {
+                continue;
+            }
+            Blocks.SetNum(Block.Index - Blocks[0].Index);
+        }
+
+        if (Blocks.Num() > 0 && !Links(Blocks.Last(), Block))
+        {
+            return INDEX_NONE;
+        }
+
+        Blocks.Add(MoveTemp(Block));
+        ++Taken;
+    }
+    return Taken;
+}
+
+bool FInterverseLedgerMirror::Links(const FInterverseLedgerBlock& Previous, const FInterverseLedgerBlock& Next)
+{
+    // Every block after genesis must name its parent
+    return Next.Index == Previous.Index + 1 &&
+        !Next.PreviousHash.IsEmpty() && Next.PreviousHash == Previous.Hash;
+}
+
+FString FInterverseLedgerMirror::ToJsonString() const
+{
+    TArray<TSharedPtr<FJsonValue>> ChainValues;
+    ChainValues.Reserve(Blocks.Num());
+    for (const FInterverseLedgerBlock& Block : Blocks)
+    {
+        TArray<TSharedPtr<FJsonValue>> TransactionValues;
+        for (const FString& Transaction : Block.Transactions)
+        {
+            // Stored condensed, so parse back to keep objects as objects
+            TSharedPtr<FJsonValue> Value;
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Transaction);
+            if (!FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+            {
+                Value = MakeShared<FJsonValueString>(Transaction);
+            }
+            TransactionValues.Add(Value);
+        }
+
+        TSharedPtr<FJsonObject> BlockObject = MakeShared<FJsonObject>();
+        BlockObject->SetNumberField(TEXT("index"), static_cast<double>(Block.Index));
+        BlockObject->SetStringField(TEXT("hash"), Block.Hash);
+        BlockObject->SetStringField(TEXT("previous_hash"), Block.PreviousHash);
+        BlockObject->SetNumberField(TEXT("timestamp"), Block.Timestamp);
+        BlockObject->SetArrayField(TEXT("transactions"), TransactionValues);
+        ChainValues.Add(MakeShared<FJsonValueObject>(BlockObject));
+    }
+
+    TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetArrayField(TEXT("chain"), ChainValues);
+    Root->SetNumberField(TEXT("length"), Blocks.Num());
+
+    FString Result;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
+    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+    return Result;
+}
+
+void FInterverseLedgerMirror::SaveToBytes(TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes);
+
+    uint32 Magic = LedgerFileMagic;
+    int32 Version = LedgerFileVersion;
+    Writer << Magic;
+    Writer << Version;
+    Writer << const_cast<TArray<FInterverseLedgerBlock>&>(Blocks);
+}
+
+bool FInterverseLedgerMirror::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    Reader << Magic;
+    Reader << Version;
+    if (Reader.IsError() || Magic != LedgerFileMagic || Version != LedgerFileVersion)
+    {
+        return false;
+    }
+
+    TArray<FInterverseLedgerBlock> Loaded;
+    Reader << Loaded;
+    if (Reader.IsError())
+    {
+        return false;
+    }
+
+    for (int32 Index = 1; Index < Loaded.Num(); ++Index)
+    {
+        if (!Links(Loaded[Index - 1], Loaded[Index]))
+        {
+            return false;
+        }
+    }
+
+    Blocks = MoveTemp(Loaded);
+    return true;
+}
+
+bool FInterverseLedgerMirror::DecodeBlocks(const FString& Content, TArray<FInterverseLedgerBlock>& OutBlocks)
+{
+    static const TCHAR* const ChainPaths[] = { TEXT("chain"), TEXT("blocks"), TEXT("data") };
+
+    return FInterverseJsonListReader::ForEachItem(Content, ChainPaths, [&OutBlocks](const TSharedPtr<FJsonValue>& Item)
+    {
+        const TSharedPtr<FJsonObject>* BlockObject;
+        if (!Item->TryGetObject(BlockObject))
+        {
+            return;
+        }
+
+        FInterverseLedgerBlock Block;
+        if (!(*BlockObject)->TryGetNumberField(TEXT("index"), Block.Index))
+        {
+            (*BlockObject)->TryGetNumberField(TEXT("height"), Block.Index);
+        }
+        (*BlockObject)->TryGetStringField(TEXT("hash"), Block.Hash);
+        (*BlockObject)->TryGetStringField(TEXT("previous_hash"), Block.PreviousHash);
+        (*BlockObject)->TryGetNumberField(TEXT("timestamp"), Block.Timestamp);
+
+        const TArray<TSharedPtr<FJsonValue>>* TransactionValues;
+        if ((*BlockObject)->TryGetArrayField(TEXT("transactions"), TransactionValues))
+        {
+            Block.Transactions.Reserve(TransactionValues->Num());
+            for (const TSharedPtr<FJsonValue>& Value : *TransactionValues)
+            {
+                FString Transaction;
+                Block.Transactions.Add(Value->TryGetString(Transaction) ? Transaction : WriteCondensed(Value));
+            }
+        }
+
+        OutBlocks.Add(MoveTemp(Block));
+    });
+}
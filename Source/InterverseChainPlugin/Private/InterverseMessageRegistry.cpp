@@ -0,0 +1,111 @@
+#include "InterverseMessageRegistry.h"
+#include "InterverseConnectionManager.h"
+#include "InterverseCompatibility.h"
+
+namespace InterverseMessageTypes
+{
+    const FName AssetUpdate(TEXT("asset_update"));
+    const FName AssetMinted(TEXT("asset_minted"));
+    const FName BalanceUpdate(TEXT("balance_update"));
+    const FName TransferComplete(TEXT("transfer_complete"));
+    const FName HandshakeAck(TEXT("handshake_ack"));
+}
+
+namespace
+{
+    // Frames without an asset id would reach the cache and the delegates as a blank asset
+    bool DecodeAssetField(const FJsonObject& Json, const TCHAR* Field, FInterverseDecodedPayload& Out)
+    {
+        Out.Asset = FInterverseAsset();
+        const TSharedPtr<FJsonObject>* AssetObject;
+        return Json.TryGetObjectField(Field, AssetObject) &&
+            InterverseCompat::ConvertJsonToAsset(*AssetObject, Out.Asset) &&
+            !Out.Asset.AssetId.IsEmpty();
+    }
+
+    bool DecodeAssetUpdate(const FJsonObject& Json, FInterverseDecodedPayload& Out)
+    {
+        return DecodeAssetField(Json, TEXT("asset"), Out);
+    }
+
+    // Pushed mints carry the asset like asset_update; some nodes wrap it in "data" as the REST reply does
+    bool DecodeAssetMinted(const FJsonObject& Json, FInterverseDecodedPayload& Out)
+    {
+        return DecodeAssetField(Json, TEXT("asset"), Out) || DecodeAssetField(Json, TEXT("data"), Out);
+    }
+
+    bool DecodeBalanceUpdate(const FJsonObject& Json, FInterverseDecodedPayload& Out)
+    {
+        const TSharedPtr<FJsonObject>* DataObject;
+        if (!Json.TryGetObjectField(TEXT("data"), DataObject))
+        {
+            return false;
+        }
+
+        Out.Balance = static_cast<float>((*DataObject)->GetNumberField(TEXT("balance")));
+        (*DataObject)->TryGetStringField(TEXT("address"), Out.Address);
+        return true;
+    }
+
+    bool DecodeTransferComplete(const FJsonObject& Json, FInterverseDecodedPayload& Out)
+    {
+        const TSharedPtr<FJsonObject>* DataObject;
+        if (!Json.TryGetObjectField(TEXT("data"), DataObject))
+        {
+            return false;
+        }
+
+        Out.AssetId = (*DataObject)->GetStringField(TEXT("asset_id"));
+        Out.bSuccess = (*DataObject)->GetBoolField(TEXT("success"));
+        return true;
+    }
+}
+
+FInterverseMessageRegistry& FInterverseMessageRegistry::Get()
+{
+    static FInterverseMessageRegistry Registry;
+    return Registry;
+}
+
+FInterverseMessageRegistry::FInterverseMessageRegistry()
+{
+    Decoders.Add(InterverseMessageTypes::AssetUpdate, &DecodeAssetUpdate);
+    Decoders.Add(InterverseMessageTypes::AssetMinted, &DecodeAssetMinted);
+    Decoders.Add(InterverseMessageTypes::BalanceUpdate, &DecodeBalanceUpdate);
+    Decoders.Add(InterverseMessageTypes::TransferComplete, &DecodeTransferComplete);
+}
+
+void FInterverseMessageRegistry::RegisterDecoder(FName Type, FInterverseMessageDecoder Decoder)
+{
+    FWriteScopeLock WriteLock(Lock);
+    Decoders.Add(Type, MoveTemp(Decoder));
+}
+
+void FInterverseMessageRegistry::UnregisterDecoder(FName Type)
+{
+    FWriteScopeLock WriteLock(Lock);
+    Decoders.Remove(Type);
+}
+
+FName FInterverseMessageRegistry::FindType(const FString& TypeString)
+{
+    return TypeString.IsEmpty() ? NAME_None : FName(*TypeString, FNAME_Find);
+}
+
+bool FInterverseMessageRegistry::Decode(FName Type, const TSharedPtr<FJsonObject>& Json, FInterverseDecodedPayload& Out) const
+{
+    if (Type.IsNone() || !Json.IsValid())
+    {
+        return false;
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    if (const FInterverseMessageDecoder* Decoder = Decoders.Find(Type))
+    {
+        return (*Decoder)(*Json, Out);
+    }
+
+    // Game-defined types without a decoder are handed over as JSON
+    Out.Json = Json;
+    return true;
+}
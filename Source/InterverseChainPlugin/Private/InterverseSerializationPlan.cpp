@@ -0,0 +1,338 @@
+#include "InterverseSerializationPlan.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchiveAdapters.h"
+
+namespace
+{
+    constexpr uint32 PropertyStreamMagic = 0x50525049; // "IPRP"
+    constexpr int32 PropertyStreamVersion = 2;
+
+    void SerializeValue(FArchive& Ar, const FInterverseSerializedProperty& Entry, UObject* Object)
+    {
+        FStructuredArchiveFromArchive Structured(Ar);
+        Entry.Property->SerializeItem(Structured.GetSlot(), Entry.GetValuePtr(Object), nullptr);
+    }
+
+    // GetCPPType alone is "TArray" or "TMap" for every container; the extended text adds the inner types
+    uint32 HashPropertyType(const FProperty* Property)
+    {
+        FString ExtendedType;
+        const FString CPPType = Property->GetCPPType(&ExtendedType);
+        return FCrc::StrCrc32(*(CPPType + ExtendedType));
+    }
+
+    // Whether packing the property only copies bytes it owns. Object references resolve names through
+    // the object system and custom struct serializers run arbitrary code, so neither qualifies.
+    bool IsPlainData(const FProperty* Property)
+    {
+        if (Property->IsA<FNumericProperty>() || Property->IsA<FBoolProperty>() || Property->IsA<FEnumProperty>() ||
+            Property->IsA<FStrProperty>() || Property->IsA<FNameProperty>())
+        {
+            return true;
+        }
+
+        if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+        {
+            return IsPlainData(ArrayProperty->Inner);
+        }
+        if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+        {
+            return IsPlainData(SetProperty->ElementProp);
+        }
+        if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+        {
+            return IsPlainData(MapProperty->KeyProp) && IsPlainData(MapProperty->ValueProp);
+        }
+
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            // Core math types have serializers that only write their own members
+            const UScriptStruct* Struct = StructProperty->Struct;
+            if (Struct == TBaseStructure<FVector>::Get() || Struct == TBaseStructure<FVector2D>::Get() ||
+                Struct == TBaseStructure<FRotator>::Get() || Struct == TBaseStructure<FQuat>::Get() ||
+                Struct == TBaseStructure<FLinearColor>::Get() || Struct == TBaseStructure<FColor>::Get() ||
+                Struct == TBaseStructure<FGuid>::Get())
+            {
+                return true;
+            }
+
+            const UScriptStruct::ICppStructOps* StructOps = Struct->GetCppStructOps();
+            if (StructOps && (StructOps->HasSerializer() || StructOps->HasStructuredSerializer()))
+            {
+                return false;
+            }
+
+            for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+            {
+                if (!IsPlainData(*PropIt))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    // Finds referenced objects that are already in memory and notes the rest instead of loading
+    // them synchronously, so a worker or the game thread never stalls on disk mid-read
+    class FReferenceCollectingReader : public FObjectAndNameAsStringProxyArchive
+    {
+    public:
+        FReferenceCollectingReader(FArchive& InInnerArchive, TArray<FSoftObjectPath>* InUnresolved)
+            : FObjectAndNameAsStringProxyArchive(InInnerArchive, false)
+            , Unresolved(InUnresolved)
+        {
+        }
+
+        using FObjectAndNameAsStringProxyArchive::operator<<;
+
+        virtual FArchive& operator<<(UObject*& Obj) override
+        {
+            FString Path;
+            InnerArchive << Path;
+
+            Obj = nullptr;
+            if (Path.IsEmpty() || Path == TEXT("None"))
+            {
+                return *this;
+            }
+
+            Obj = FindObject<UObject>(nullptr, *Path);
+            if (!Obj && Unresolved)
+            {
+                Unresolved->AddUnique(FSoftObjectPath(Path));
+            }
+            return *this;
+        }
+
+    private:
+        TArray<FSoftObjectPath>* Unresolved;
+    };
+
+    struct FPlanCache
+    {
+        FRWLock Lock;
+        TMap<FObjectKey, TSharedRef<const FInterverseSerializationPlan>> Plans;
+
+        FDelegateHandle ReloadCompleteHandle;
+        FDelegateHandle ObjectsReplacedHandle;
+    };
+
+    FPlanCache& GetPlanCache()
+    {
+        static FPlanCache Cache;
+        return Cache;
+    }
+}
+
+FInterverseSerializationPlan::FInterverseSerializationPlan(const UClass* Class)
+{
+    for (TFieldIterator<FProperty> PropIt(Class); PropIt; ++PropIt)
+    {
+        FProperty* Property = *PropIt;
+        if (!Property->HasAnyPropertyFlags(CPF_SaveGame))
+        {
+            continue;
+        }
+
+        FInterverseSerializedProperty& Entry = Properties.AddDefaulted_GetRef();
+        Entry.Property = Property;
+        Entry.Offset = Property->GetOffset_ForInternal();
+        Entry.Name = Property->GetFName();
+        Entry.Key = Property->GetName();
+        Entry.TypeHash = HashPropertyType(Property);
+        IndexByName.Add(Entry.Name, Properties.Num() - 1);
+
+        bPlainData &= IsPlainData(Property);
+    }
+}
+
+TSharedRef<const FInterverseSerializationPlan> FInterverseSerializationPlan::Get(const UClass* Class)
+{
+    check(Class);
+    FPlanCache& Cache = GetPlanCache();
+    const FObjectKey Key(Class);
+
+    {
+        FReadScopeLock ReadLock(Cache.Lock);
+        if (const TSharedRef<const FInterverseSerializationPlan>* Plan = Cache.Plans.Find(Key))
+        {
+            return *Plan;
+        }
+    }
+
+    TSharedRef<const FInterverseSerializationPlan> Plan = MakeShareable(new FInterverseSerializationPlan(Class));
+
+    // Another thread may have built the same plan meanwhile; keep whichever landed first
+    FWriteScopeLock WriteLock(Cache.Lock);
+    if (const TSharedRef<const FInterverseSerializationPlan>* Existing = Cache.Plans.Find(Key))
+    {
+        return *Existing;
+    }
+    Cache.Plans.Add(Key, Plan);
+    return Plan;
+}
+
+void FInterverseSerializationPlan::InvalidateAll()
+{
+    FPlanCache& Cache = GetPlanCache();
+    FWriteScopeLock WriteLock(Cache.Lock);
+    Cache.Plans.Reset();
+}
+
+void FInterverseSerializationPlan::RegisterInvalidationHooks()
+{
+    FPlanCache& Cache = GetPlanCache();
+
+    Cache.ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+    {
+        InvalidateAll();
+    });
+
+    // Blueprint compiles reinstance classes without a module reload
+    Cache.ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>& ReplacedObjects)
+    {
+        for (const TPair<UObject*, UObject*>& Pair : ReplacedObjects)
+        {
+            if (Cast<UClass>(Pair.Key))
+            {
+                InvalidateAll();
+                return;
+            }
+        }
+    });
+}
+
+void FInterverseSerializationPlan::UnregisterInvalidationHooks()
+{
+    FPlanCache& Cache = GetPlanCache();
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(Cache.ReloadCompleteHandle);
+    FCoreUObjectDelegates::OnObjectsReplaced.Remove(Cache.ObjectsReplacedHandle);
+    InvalidateAll();
+}
+
+const FInterverseSerializedProperty* FInterverseSerializationPlan::FindProperty(const FString& Key) const
+{
+    // Keys naming a property this build never had are not in the name table either
+    const FName Name(*Key, FNAME_Find);
+    if (Name.IsNone())
+    {
+        return nullptr;
+    }
+
+    const int32* Index = IndexByName.Find(Name);
+    return Index ? &Properties[*Index] : nullptr;
+}
+
+void FInterverseSerializationPlan::WriteText(UObject* Object, TMap<FString, FString>& OutValues) const
+{
+    OutValues.Reserve(OutValues.Num() + Properties.Num());
+    for (const FInterverseSerializedProperty& Entry : Properties)
+    {
+        void* PropertyValue = Entry.GetValuePtr(Object);
+        FString ValueString;
+        Entry.Property->ExportTextItem_Direct(ValueString, PropertyValue, PropertyValue, Object, PPF_None);
+        OutValues.Add(Entry.Key, MoveTemp(ValueString));
+    }
+}
+
+void FInterverseSerializationPlan::ReadText(UObject* Object, const TMap<FString, FString>& Values) const
+{
+    for (const TPair<FString, FString>& Pair : Values)
+    {
+        if (const FInterverseSerializedProperty* Entry = FindProperty(Pair.Key))
+        {
+            const TCHAR* ImportText = *Pair.Value;
+            Entry->Property->ImportText_Direct(ImportText, Entry->GetValuePtr(Object), Object, PPF_None);
+        }
+    }
+}
+
+void FInterverseSerializationPlan::WriteBinary(UObject* Object, TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes);
+
+    // Object references and names travel as paths so they resolve in the receiving process
+    FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+
+    uint32 Magic = PropertyStreamMagic;
+    int32 Version = PropertyStreamVersion;
+    int32 Count = Properties.Num();
+    Ar << Magic;
+    Ar << Version;
+    Ar << Count;
+
+    for (const FInterverseSerializedProperty& Entry : Properties)
+    {
+        FString Key = Entry.Key;
+        uint32 TypeHash = Entry.TypeHash;
+        Ar << Key;
+        Ar << TypeHash;
+
+        // Size is patched in afterwards so readers can skip values they don't understand
+        const int64 SizePos = Ar.Tell();
+        int32 Size = 0;
+        Ar << Size;
+
+        const int64 Start = Ar.Tell();
+        SerializeValue(Ar, Entry, Object);
+        const int64 End = Ar.Tell();
+
+        Size = static_cast<int32>(End - Start);
+        Ar.Seek(SizePos);
+        Ar << Size;
+        Ar.Seek(End);
+    }
+}
+
+bool FInterverseSerializationPlan::ReadBinary(UObject* Object, const TArray<uint8>& Bytes, TArray<FSoftObjectPath>* OutUnresolved) const
+{
+    FMemoryReader Reader(Bytes);
+    FReferenceCollectingReader Ar(Reader, OutUnresolved);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 Count = 0;
+    Ar << Magic;
+    Ar << Version;
+    Ar << Count;
+    if (Ar.IsError() || Magic != PropertyStreamMagic || Version != PropertyStreamVersion || Count < 0)
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        FString Key;
+        uint32 TypeHash = 0;
+        int32 Size = 0;
+        Ar << Key;
+        Ar << TypeHash;
+        Ar << Size;
+
+        const int64 Start = Ar.Tell();
+        if (Ar.IsError() || Size < 0 || Start + Size > Ar.TotalSize())
+        {
+            return false;
+        }
+
+        const FInterverseSerializedProperty* Entry = FindProperty(Key);
+        if (Entry && Entry->TypeHash == TypeHash)
+        {
+            SerializeValue(Ar, *Entry, Object);
+        }
+
+        // Always resume at the next value, whether this one was read, skipped or misread
+        Ar.Seek(Start + Size);
+    }
+
+    return !Ar.IsError();
+}
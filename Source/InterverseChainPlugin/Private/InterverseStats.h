@@ -0,0 +1,7 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// View with "stat Interverse" in a running session
+DECLARE_STATS_GROUP(TEXT("Interverse"), STATGROUP_Interverse, STATCAT_Advanced);
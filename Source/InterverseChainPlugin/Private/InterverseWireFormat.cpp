@@ -0,0 +1,501 @@
+#include "InterverseWireFormat.h"
+#include "Json.h"
+
+namespace
+{
+    // Deeper documents than this are rejected rather than risking the stack on hostile input
+    constexpr int32 MaxDecodeDepth = 64;
+
+    void AppendBigEndian(TArray<uint8>& Bytes, uint64 Value, int32 NumBytes)
+    {
+        for (int32 Shift = (NumBytes - 1) * 8; Shift >= 0; Shift -= 8)
+        {
+            Bytes.Add(static_cast<uint8>(Value >> Shift));
+        }
+    }
+
+    void AppendSizedHeader(TArray<uint8>& Bytes, uint32 Count, uint8 FixBase, uint32 FixLimit, uint8 Marker16, uint8 Marker32)
+    {
+        if (Count < FixLimit)
+        {
+            Bytes.Add(static_cast<uint8>(FixBase | Count));
+        }
+        else if (Count <= MAX_uint16)
+        {
+            Bytes.Add(Marker16);
+            AppendBigEndian(Bytes, Count, 2);
+        }
+        else
+        {
+            Bytes.Add(Marker32);
+            AppendBigEndian(Bytes, Count, 4);
+        }
+    }
+
+    void AppendNumber(TArray<uint8>& Bytes, double Value)
+    {
+        // JSON numbers are doubles; whole ones go out in the smallest integer form
+        if (FMath::IsFinite(Value) && Value == FMath::FloorToDouble(Value) && Value >= -9223372036854775808.0 && Value < 9223372036854775808.0)
+        {
+            const int64 Integer = static_cast<int64>(Value);
+            if (Integer >= 0)
+            {
+                if (Integer < 0x80)
+                {
+                    Bytes.Add(static_cast<uint8>(Integer));
+                }
+                else if (Integer <= MAX_uint8)
+                {
+                    Bytes.Add(0xcc);
+                    AppendBigEndian(Bytes, Integer, 1);
+                }
+                else if (Integer <= MAX_uint16)
+                {
+                    Bytes.Add(0xcd);
+                    AppendBigEndian(Bytes, Integer, 2);
+                }
+                else if (Integer <= MAX_uint32)
+                {
+                    Bytes.Add(0xce);
+                    AppendBigEndian(Bytes, Integer, 4);
+                }
+                else
+                {
+                    Bytes.Add(0xcf);
+                    AppendBigEndian(Bytes, Integer, 8);
+                }
+            }
+            else if (Integer >= -32)
+            {
+                Bytes.Add(static_cast<uint8>(Integer));
+            }
+            else if (Integer >= MIN_int8)
+            {
+                Bytes.Add(0xd0);
+                AppendBigEndian(Bytes, static_cast<uint64>(Integer), 1);
+            }
+            else if (Integer >= MIN_int16)
+            {
+                Bytes.Add(0xd1);
+                AppendBigEndian(Bytes, static_cast<uint64>(Integer), 2);
+            }
+            else if (Integer >= MIN_int32)
+            {
+                Bytes.Add(0xd2);
+                AppendBigEndian(Bytes, static_cast<uint64>(Integer), 4);
+            }
+            else
+            {
+                Bytes.Add(0xd3);
+                AppendBigEndian(Bytes, static_cast<uint64>(Integer), 8);
+            }
+            return;
+        }
+
+        // Most gameplay values came from floats, so they fit in four bytes without loss
+        const float Single = static_cast<float>(Value);
+        if (static_cast<double>(Single) == Value)
+        {
+            Bytes.Add(0xca);
+            AppendBigEndian(Bytes, FMath::AsUInt(Single), 4);
+        }
+        else
+        {
+            Bytes.Add(0xcb);
+            AppendBigEndian(Bytes, FMath::AsUInt(Value), 8);
+        }
+    }
+
+    void AppendObject(TArray<uint8>& Bytes, const FJsonObject& Object);
+
+    void AppendValue(TArray<uint8>& Bytes, const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Value.IsValid())
+        {
+            Bytes.Add(0xc0);
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::String:
+            InterverseWire::AppendString(Bytes, Value->AsString());
+            break;
+
+        case EJson::Number:
+            AppendNumber(Bytes, Value->AsNumber());
+            break;
+
+        case EJson::Boolean:
+            Bytes.Add(Value->AsBool() ? 0xc3 : 0xc2);
+            break;
+
+        case EJson::Array:
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Values = Value->AsArray();
+            InterverseWire::AppendArrayHeader(Bytes, Values.Num());
+            for (const TSharedPtr<FJsonValue>& Element : Values)
+            {
+                AppendValue(Bytes, Element);
+            }
+            break;
+        }
+
+        case EJson::Object:
+        {
+            const TSharedPtr<FJsonObject> Object = Value->AsObject();
+            if (Object.IsValid())
+            {
+                AppendObject(Bytes, *Object);
+            }
+            else
+            {
+                Bytes.Add(0xc0);
+            }
+            break;
+        }
+
+        default:
+            Bytes.Add(0xc0);
+            break;
+        }
+    }
+
+    void AppendObject(TArray<uint8>& Bytes, const FJsonObject& Object)
+    {
+        InterverseWire::AppendMapHeader(Bytes, Object.Values.Num());
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object.Values)
+        {
+            InterverseWire::AppendString(Bytes, Pair.Key);
+            AppendValue(Bytes, Pair.Value);
+        }
+    }
+
+    class FMessagePackReader
+    {
+    public:
+        explicit FMessagePackReader(TArrayView<const uint8> InBytes)
+            : Bytes(InBytes)
+        {
+        }
+
+        bool IsAtEnd() const { return Offset == Bytes.Num(); }
+
+        TSharedPtr<FJsonValue> ReadValue(int32 Depth)
+        {
+            uint8 Marker;
+            if (Depth > MaxDecodeDepth || !ReadByte(Marker))
+            {
+                return nullptr;
+            }
+
+            if (Marker <= 0x7f)
+            {
+                return MakeNumber(Marker);
+            }
+            if (Marker >= 0xe0)
+            {
+                return MakeNumber(static_cast<int8>(Marker));
+            }
+            if ((Marker & 0xf0) == 0x80)
+            {
+                return ReadMap(Marker & 0x0f, Depth);
+            }
+            if ((Marker & 0xf0) == 0x90)
+            {
+                return ReadArray(Marker & 0x0f, Depth);
+            }
+            if ((Marker & 0xe0) == 0xa0)
+            {
+                return ReadStringValue(Marker & 0x1f);
+            }
+
+            uint64 Raw = 0;
+            switch (Marker)
+            {
+            case 0xc0: return MakeShared<FJsonValueNull>();
+            case 0xc2: return MakeShared<FJsonValueBoolean>(false);
+            case 0xc3: return MakeShared<FJsonValueBoolean>(true);
+
+            case 0xca: return ReadBigEndian(4, Raw) ? MakeNumber(FMath::AsFloat(static_cast<uint32>(Raw))) : nullptr;
+            case 0xcb: return ReadBigEndian(8, Raw) ? MakeNumber(FMath::AsFloat(Raw)) : nullptr;
+
+            case 0xcc: return ReadBigEndian(1, Raw) ? MakeNumber(static_cast<double>(Raw)) : nullptr;
+            case 0xcd: return ReadBigEndian(2, Raw) ? MakeNumber(static_cast<double>(Raw)) : nullptr;
+            case 0xce: return ReadBigEndian(4, Raw) ? MakeNumber(static_cast<double>(Raw)) : nullptr;
+            case 0xcf: return ReadBigEndian(8, Raw) ? MakeNumber(static_cast<double>(Raw)) : nullptr;
+
+            case 0xd0: return ReadBigEndian(1, Raw) ? MakeNumber(static_cast<int8>(Raw)) : nullptr;
+            case 0xd1: return ReadBigEndian(2, Raw) ? MakeNumber(static_cast<int16>(Raw)) : nullptr;
+            case 0xd2: return ReadBigEndian(4, Raw) ? MakeNumber(static_cast<int32>(Raw)) : nullptr;
+            case 0xd3: return ReadBigEndian(8, Raw) ? MakeNumber(static_cast<double>(static_cast<int64>(Raw))) : nullptr;
+
+            case 0xd9: return ReadBigEndian(1, Raw) ? ReadStringValue(Raw) : nullptr;
+            case 0xda: return ReadBigEndian(2, Raw) ? ReadStringValue(Raw) : nullptr;
+            case 0xdb: return ReadBigEndian(4, Raw) ? ReadStringValue(Raw) : nullptr;
+
+            case 0xdc: return ReadBigEndian(2, Raw) ? ReadArray(Raw, Depth) : nullptr;
+            case 0xdd: return ReadBigEndian(4, Raw) ? ReadArray(Raw, Depth) : nullptr;
+
+            case 0xde: return ReadBigEndian(2, Raw) ? ReadMap(Raw, Depth) : nullptr;
+            case 0xdf: return ReadBigEndian(4, Raw) ? ReadMap(Raw, Depth) : nullptr;
+
+            default:
+                // bin and ext have no JSON equivalent
+                return nullptr;
+            }
+        }
+
+    private:
+        TArrayView<const uint8> Bytes;
+        int32 Offset = 0;
+
+        bool ReadByte(uint8& OutByte)
+        {
+            if (Offset >= Bytes.Num())
+            {
+                return false;
+            }
+            OutByte = Bytes[Offset++];
+            return true;
+        }
+
+        bool ReadBigEndian(int32 NumBytes, uint64& OutValue)
+        {
+            if (Bytes.Num() - Offset < NumBytes)
+            {
+                return false;
+            }
+
+            OutValue = 0;
+            for (int32 Index = 0; Index < NumBytes; ++Index)
+            {
+                OutValue = (OutValue << 8) | Bytes[Offset++];
+            }
+            return true;
+        }
+
+        bool ReadString(uint64 Length, FString& OutString)
+        {
+            if (static_cast<uint64>(Bytes.Num() - Offset) < Length)
+            {
+                return false;
+            }
+
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + Offset), static_cast<int32>(Length));
+            OutString = FString(Converted.Length(), Converted.Get());
+            Offset += static_cast<int32>(Length);
+            return true;
+        }
+
+        TSharedPtr<FJsonValue> ReadStringValue(uint64 Length)
+        {
+            FString Value;
+            if (!ReadString(Length, Value))
+            {
+                return nullptr;
+            }
+            return MakeShared<FJsonValueString>(MoveTemp(Value));
+        }
+
+        static TSharedPtr<FJsonValue> MakeNumber(double Value)
+        {
+            return MakeShared<FJsonValueNumber>(Value);
+        }
+
+        TSharedPtr<FJsonValue> ReadArray(uint64 Count, int32 Depth)
+        {
+            // Every element takes at least a byte, which bounds the reserve on forged counts
+            if (Count > static_cast<uint64>(Bytes.Num() - Offset))
+            {
+                return nullptr;
+            }
+
+            TArray<TSharedPtr<FJsonValue>> Values;
+            Values.Reserve(static_cast<int32>(Count));
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                TSharedPtr<FJsonValue> Value = ReadValue(Depth + 1);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Values.Add(MoveTemp(Value));
+            }
+            return MakeShared<FJsonValueArray>(Values);
+        }
+
+        TSharedPtr<FJsonValue> ReadMap(uint64 Count, int32 Depth)
+        {
+            if (Count * 2 > static_cast<uint64>(Bytes.Num() - Offset))
+            {
+                return nullptr;
+            }
+
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            Object->Values.Reserve(static_cast<int32>(Count));
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                TSharedPtr<FJsonValue> Key = ReadValue(Depth + 1);
+                if (!Key.IsValid() || Key->Type != EJson::String)
+                {
+                    return nullptr;
+                }
+
+                TSharedPtr<FJsonValue> Value = ReadValue(Depth + 1);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Object->SetField(Key->AsString(), Value);
+            }
+            return MakeShared<FJsonValueObject>(Object);
+        }
+    };
+
+    TSharedPtr<FJsonObject> ParseJson(const FString& Json)
+    {
+        TSharedPtr<FJsonObject> Object;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        FJsonSerializer::Deserialize(Reader, Object);
+        return Object;
+    }
+}
+
+namespace InterverseWire
+{
+    const TCHAR* GetContentType(EInterverseWireFormat Format)
+    {
+        return Format == EInterverseWireFormat::MessagePack ? TEXT("application/msgpack") : TEXT("application/json");
+    }
+
+    const TCHAR* GetFormatName(EInterverseWireFormat Format)
+    {
+        return Format == EInterverseWireFormat::MessagePack ? TEXT("msgpack") : TEXT("json");
+    }
+
+    bool FindFormat(const FString& Name, EInterverseWireFormat& OutFormat)
+    {
+        if (Name.Equals(TEXT("msgpack"), ESearchCase::IgnoreCase))
+        {
+            OutFormat = EInterverseWireFormat::MessagePack;
+            return true;
+        }
+        if (Name.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+        {
+            OutFormat = EInterverseWireFormat::Json;
+            return true;
+        }
+        return false;
+    }
+
+    FString ToJsonString(const TSharedRef<FJsonObject>& Object)
+    {
+        FString Result;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Result);
+        FJsonSerializer::Serialize(Object, Writer);
+        return Result;
+    }
+
+    void ToMessagePack(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutBytes)
+    {
+        OutBytes.Reset();
+        AppendObject(OutBytes, *Object);
+    }
+
+    void ToMessagePack(const TSharedPtr<FJsonValue>& Value, TArray<uint8>& OutBytes)
+    {
+        OutBytes.Reset();
+        AppendValue(OutBytes, Value);
+    }
+
+    TSharedPtr<FJsonObject> FromMessagePack(TArrayView<const uint8> Bytes)
+    {
+        FMessagePackReader Reader(Bytes);
+        TSharedPtr<FJsonValue> Value = Reader.ReadValue(0);
+        if (!Value.IsValid() || Value->Type != EJson::Object || !Reader.IsAtEnd())
+        {
+            return nullptr;
+        }
+        return Value->AsObject();
+    }
+
+    void AppendMapHeader(TArray<uint8>& Bytes, uint32 NumPairs)
+    {
+        AppendSizedHeader(Bytes, NumPairs, 0x80, 16, 0xde, 0xdf);
+    }
+
+    void AppendArrayHeader(TArray<uint8>& Bytes, uint32 NumElements)
+    {
+        AppendSizedHeader(Bytes, NumElements, 0x90, 16, 0xdc, 0xdd);
+    }
+
+    void AppendString(TArray<uint8>& Bytes, const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value, Value.Len());
+        const uint32 Length = Utf8.Length();
+        if (Length < 32)
+        {
+            Bytes.Add(static_cast<uint8>(0xa0 | Length));
+        }
+        else if (Length <= MAX_uint8)
+        {
+            Bytes.Add(0xd9);
+            AppendBigEndian(Bytes, Length, 1);
+        }
+        else
+        {
+            AppendSizedHeader(Bytes, Length, 0, 0, 0xda, 0xdb);
+        }
+        Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+    }
+
+    FInterverseWireComparison Compare(const TSharedRef<FJsonObject>& Object, int32 Iterations)
+    {
+        Iterations = FMath::Max(1, Iterations);
+        FInterverseWireComparison Result;
+
+        // JSON is timed including the UTF-16/UTF-8 conversion, since that is what it costs on the wire
+        FString Json;
+        TArray<uint8> JsonBytes;
+        double Start = FPlatformTime::Seconds();
+        for (int32 Pass = 0; Pass < Iterations; ++Pass)
+        {
+            Json = ToJsonString(Object);
+            const FTCHARToUTF8 Utf8(*Json, Json.Len());
+            JsonBytes.Reset();
+            JsonBytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        }
+        Result.JsonEncodeUs = (FPlatformTime::Seconds() - Start) * 1.0e6 / Iterations;
+        Result.JsonBytes = JsonBytes.Num();
+
+        Start = FPlatformTime::Seconds();
+        for (int32 Pass = 0; Pass < Iterations; ++Pass)
+        {
+            const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(JsonBytes.GetData()), JsonBytes.Num());
+            ParseJson(FString(Text.Length(), Text.Get()));
+        }
+        Result.JsonDecodeUs = (FPlatformTime::Seconds() - Start) * 1.0e6 / Iterations;
+
+        TArray<uint8> PackedBytes;
+        Start = FPlatformTime::Seconds();
+        for (int32 Pass = 0; Pass < Iterations; ++Pass)
+        {
+            ToMessagePack(Object, PackedBytes);
+        }
+        Result.MessagePackEncodeUs = (FPlatformTime::Seconds() - Start) * 1.0e6 / Iterations;
+        Result.MessagePackBytes = PackedBytes.Num();
+
+        TSharedPtr<FJsonObject> Decoded;
+        Start = FPlatformTime::Seconds();
+        for (int32 Pass = 0; Pass < Iterations; ++Pass)
+        {
+            Decoded = FromMessagePack(PackedBytes);
+        }
+        Result.MessagePackDecodeUs = (FPlatformTime::Seconds() - Start) * 1.0e6 / Iterations;
+
+        Result.bRoundTripped = Decoded.IsValid() && ToJsonString(Decoded.ToSharedRef()) == Json;
+        return Result;
+    }
+}
@@ -0,0 +1,95 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseCompactTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    const TCHAR* const TestMetadataKeys[] = {
+        TEXT("Damage"), TEXT("DamageType"), TEXT("DurabilityPoints"), TEXT("AttackSpeed"),
+        TEXT("CriticalChance"), TEXT("ElementalAffinity"), TEXT("SetBonus"), TEXT("Origin")
+    };
+
+    FInterverseAsset MakeTestAsset(int32 Index)
+    {
+        FInterverseAsset Asset;
+        Asset.AssetId = FString::Printf(TEXT("Asset_%d"), Index);
+        Asset.Owner = TEXT("0xWallet");
+        Asset.Category = static_cast<EInterverseItemCategory>(Index % 8);
+        for (const TCHAR* Key : TestMetadataKeys)
+        {
+            Asset.Metadata.Add(Key, FString::FromInt(Index));
+        }
+        return Asset;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseCompactAssetTest, "Interverse.Compact.Asset",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseCompactAssetTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumAssets = 10000;
+
+    SIZE_T StructBytes = 0;
+    SIZE_T CompactBytes = 0;
+    int32 RoundTripped = 0;
+    for (int32 Index = 0; Index < NumAssets; ++Index)
+    {
+        const FInterverseAsset Asset = MakeTestAsset(Index);
+        const FInterverseCompactAsset Compact = FInterverseCompactAsset::FromAsset(Asset);
+
+        StructBytes += sizeof(FInterverseAsset) + InterverseCompact::GetAllocatedSize(Asset);
+        CompactBytes += sizeof(FInterverseCompactAsset) + Compact.GetAllocatedSize();
+
+        const FInterverseAsset Back = Compact.ToAsset();
+        if (Back.AssetId == Asset.AssetId && Back.Category == Asset.Category && Back.Metadata.OrderIndependentCompareEqual(Asset.Metadata))
+        {
+            ++RoundTripped;
+        }
+    }
+
+    TestEqual(TEXT("Every asset converts back unchanged"), RoundTripped, NumAssets);
+    TestTrue(TEXT("Compact form is smaller"), CompactBytes < StructBytes);
+
+    const FInterverseCompactAsset Compact = FInterverseCompactAsset::FromAsset(MakeTestAsset(7));
+    const FString* Damage = Compact.FindMetadata(TEXT("Damage"));
+    TestTrue(TEXT("Lookup by key"), Damage && *Damage == TEXT("7"));
+    TestNull(TEXT("Keys are case-sensitive"), Compact.FindMetadata(TEXT("damage")));
+
+    AddInfo(FString::Printf(TEXT("Bytes per asset: %.1f as FInterverseAsset, %.1f compact"),
+        static_cast<double>(StructBytes) / NumAssets, static_cast<double>(CompactBytes) / NumAssets));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseCompactPropertiesTest, "Interverse.Compact.Properties",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseCompactPropertiesTest::RunTest(const FString& Parameters)
+{
+    FInterverseBaseProperties Properties;
+    Properties.Category = EInterverseItemCategory::Armor;
+    Properties.Rarity = EInterverseRarity::Epic;
+    Properties.Level = 12;
+    Properties.ModelIdentifier = TEXT("Helm_03");
+    Properties.PrimaryColor = FLinearColor::Red;
+    Properties.SecondaryColor = FLinearColor::Blue;
+    Properties.NumericProperties.Add(TEXT("Defense"), 42.5f);
+    Properties.NumericProperties.Add(TEXT("Weight"), 3.0f);
+    Properties.StringProperties.Add(TEXT("Material"), TEXT("Mithril"));
+    Properties.Tags.Add(TEXT("Heavy"));
+    Properties.OwnerGlobalID = TEXT("Player_1");
+
+    const FInterverseBaseProperties Back = FInterverseCompactProperties::FromProperties(Properties).ToProperties();
+
+    TestEqual(TEXT("Level"), Back.Level, Properties.Level);
+    TestEqual(TEXT("Model"), Back.ModelIdentifier, Properties.ModelIdentifier);
+    TestEqual(TEXT("Primary color"), Back.PrimaryColor, Properties.PrimaryColor);
+    TestTrue(TEXT("Numeric properties"), Back.NumericProperties.OrderIndependentCompareEqual(Properties.NumericProperties));
+    TestTrue(TEXT("String properties"), Back.StringProperties.OrderIndependentCompareEqual(Properties.StringProperties));
+    TestEqual(TEXT("Tags"), Back.Tags, Properties.Tags);
+    TestEqual(TEXT("Owner"), Back.OwnerGlobalID, Properties.OwnerGlobalID);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,97 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseChainComponent.h"
+#include "InterverseConnectionManager.h"
+#include "Tasks/Task.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Alternates asset and balance pushes, each about the size of a real node frame
+    FString MakeTestFrame(int32 Index)
+    {
+        if (Index % 2 == 0)
+        {
+            return FString::Printf(
+                TEXT("{\"type\":\"asset_update\",\"seq\":%d,\"asset\":{\"asset_id\":\"Asset_%d\",\"owner\":\"0xWallet_%d\",\"category\":\"WEAPON\",")
+                TEXT("\"metadata\":{\"Damage\":\"%d\",\"DamageType\":\"Fire\",\"DurabilityPoints\":\"100\",\"Origin\":\"Interverse\"}}}"),
+                Index, Index, Index % 16, Index % 100);
+        }
+
+        return FString::Printf(
+            TEXT("{\"type\":\"balance_update\",\"seq\":%d,\"data\":{\"address\":\"0xWallet_%d\",\"balance\":%d.5}}"),
+            Index, Index % 16, Index);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseDecodeGameThreadCostTest, "Interverse.Decode.GameThreadCost",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseDecodeGameThreadCostTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumMessages = 2000;
+
+    TArray<FString> Frames;
+    Frames.Reserve(NumMessages);
+    for (int32 Index = 0; Index < NumMessages; ++Index)
+    {
+        Frames.Add(MakeTestFrame(Index));
+    }
+
+    // Before: every frame parsed and applied on the game thread
+    UInterverseChainComponent* Inline = NewObject<UInterverseChainComponent>();
+    double StartTime = FPlatformTime::Seconds();
+    for (const FString& Frame : Frames)
+    {
+        FInterverseDecodedPayload Payload;
+        FInterverseConnectionManager::DecodeMessage(Frame, Payload);
+        Inline->ApplyDecodedPayload(Payload);
+    }
+    const double InlineMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    // After: frames decoded on workers, only the typed result applied on the game thread
+    TArray<FInterverseDecodedPayload> Payloads;
+    Payloads.SetNum(NumMessages);
+    TArray<UE::Tasks::FTask> DecodeTasks;
+    DecodeTasks.Reserve(NumMessages);
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumMessages; ++Index)
+    {
+        DecodeTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Frames, &Payloads, Index]()
+        {
+            Payloads[Index].RawMessage = Frames[Index];
+            FInterverseConnectionManager::DecodeMessage(Frames[Index], Payloads[Index]);
+        }));
+    }
+    UE::Tasks::Wait(DecodeTasks);
+    const double WorkerMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    int32 NumValid = 0;
+    int32 NumAssets = 0;
+    for (const FInterverseDecodedPayload& Payload : Payloads)
+    {
+        NumValid += Payload.bValid ? 1 : 0;
+        NumAssets += Payload.Asset.AssetId.IsEmpty() ? 0 : 1;
+    }
+    TestEqual(TEXT("Every frame decodes on a worker"), NumValid, NumMessages);
+    TestEqual(TEXT("Asset frames carry their asset"), NumAssets, NumMessages / 2);
+    TestEqual(TEXT("Node sequence survives the worker decode"), Payloads.Last().ServerSequence, static_cast<int64>(NumMessages - 1));
+
+    UInterverseChainComponent* Deferred = NewObject<UInterverseChainComponent>();
+    StartTime = FPlatformTime::Seconds();
+    for (const FInterverseDecodedPayload& Payload : Payloads)
+    {
+        Deferred->ApplyDecodedPayload(Payload);
+    }
+    const double ApplyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    // Parsing dominates the per-message cost, so taking it off the game thread has to show up here
+    TestTrue(TEXT("Game-thread cost drops once decoding moves to workers"), ApplyMs < InlineMs);
+
+    AddInfo(FString::Printf(TEXT("%d messages: inline %.2f us/msg on the game thread, worker decode %.2f ms total, apply %.2f us/msg on the game thread"),
+        NumMessages, InlineMs * 1000.0 / NumMessages, WorkerMs, ApplyMs * 1000.0 / NumMessages));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
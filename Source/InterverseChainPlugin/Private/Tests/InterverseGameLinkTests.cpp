@@ -0,0 +1,85 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseGameLinkComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    const TCHAR* const TestGameId = TEXT("InterverseTestGame");
+
+    // Text encoding with no values, so each object costs exactly one spawn
+    FTransferredObjectData MakeReceivedObject(int32 Index)
+    {
+        FTransferredObjectData Data;
+        Data.ObjectId = FString::Printf(TEXT("Object_%d"), Index);
+        Data.ObjectClass = AActor::StaticClass()->GetPathName();
+        Data.SourceGameId = TestGameId;
+        Data.Encoding = EInterverseTransferEncoding::Text;
+        Data.bIsValid = true;
+        return Data;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseGameLinkReceiveBudgetTest, "Interverse.GameLink.ReceiveBudget",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseGameLinkReceiveBudgetTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumObjects = 2000;
+    constexpr int32 MaxFrames = 100000;
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    AActor* Owner = World->SpawnActor<AActor>();
+    UInterverseGameLinkComponent* GameLink = NewObject<UInterverseGameLinkComponent>(Owner);
+    GameLink->RegisterComponent();
+    GameLink->SpawnBudgetMs = 1.0f;
+
+    FGameLinkConfig Config;
+    Config.TargetGameId = TestGameId;
+    GameLink->RegisterGameLink(Config);
+
+    TArray<FTransferredObjectData> Objects;
+    Objects.Reserve(NumObjects);
+    for (int32 Index = 0; Index < NumObjects; ++Index)
+    {
+        Objects.Add(MakeReceivedObject(Index));
+    }
+
+    TestEqual(TEXT("Every object is queued"), GameLink->QueueReceivedObjects(Objects), NumObjects);
+    TestEqual(TEXT("Nothing spawns inside the call"), GameLink->GetReceiveStats().TotalSpawned, 0);
+
+    // Drive the core ticker the way the engine loop would, one frame at a time
+    int32 Frames = 0;
+    int32 MostSpawnsInAFrame = 0;
+    while (GameLink->GetReceiveStats().PendingSpawns > 0 && Frames < MaxFrames)
+    {
+        FTSTicker::GetCoreTicker().Tick(1.0f / 60.0f);
+        MostSpawnsInAFrame = FMath::Max(MostSpawnsInAFrame, GameLink->GetReceiveStats().LastFrameSpawns);
+        ++Frames;
+    }
+
+    const FGameLinkReceiveStats Stats = GameLink->GetReceiveStats();
+    TestEqual(TEXT("Queue drains"), Stats.PendingSpawns, 0);
+    TestEqual(TEXT("Every object spawns"), Stats.TotalSpawned, NumObjects);
+    TestEqual(TEXT("No object fails"), Stats.TotalFailed, 0);
+    TestTrue(TEXT("Spawning is spread over several frames"), Frames > 1 && MostSpawnsInAFrame < NumObjects);
+
+    // A frame may run over by the one spawn that crosses the deadline; allow generous room for that
+    // on slow machines while still catching a queue that ignores the budget
+    TestTrue(TEXT("Each frame stays near the budget"), Stats.PeakFrameSpawnMs < GameLink->SpawnBudgetMs + 10.0f);
+
+    AddInfo(FString::Printf(TEXT("%d objects over %d frames, at most %d per frame, peak %.2f ms against a %.2f ms budget"),
+        NumObjects, Frames, MostSpawnsInAFrame, Stats.PeakFrameSpawnMs, GameLink->SpawnBudgetMs));
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
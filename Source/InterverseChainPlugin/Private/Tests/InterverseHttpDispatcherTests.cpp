@@ -0,0 +1,171 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseHttpDispatcher.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "HttpServerRequest.h"
+#include "HttpPath.h"
+#include "IHttpRouter.h"
+#include "Containers/Ticker.h"
+#include "Algo/Count.h"
+
+namespace
+{
+    constexpr uint32 StubServerPort = 18555;
+
+    // Stand-in node that holds every request until the test answers it, so the test controls
+    // how long each one stays in flight
+    struct FStubNode
+    {
+        TSharedPtr<IHttpRouter> Router;
+        FHttpRouteHandle Route;
+
+        TArray<FHttpResultCallback> Held;
+        TArray<FString> Arrivals;
+        int32 MostHeld = 0;
+
+        bool Start()
+        {
+            Router = FHttpServerModule::Get().GetHttpRouter(StubServerPort, true);
+            if (!Router.IsValid())
+            {
+                return false;
+            }
+
+            Route = Router->BindRoute(FHttpPath(TEXT("/stub")), EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST,
+                FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+                {
+                    Arrivals.Add(Request.QueryParams.FindRef(TEXT("id")));
+                    Held.Add(OnComplete);
+                    MostHeld = FMath::Max(MostHeld, Held.Num());
+                    return true;
+                }));
+            FHttpServerModule::Get().StartAllListeners();
+            return Route.IsValid();
+        }
+
+        void Stop()
+        {
+            AnswerAll();
+            if (Router.IsValid() && Route.IsValid())
+            {
+                Router->UnbindRoute(Route);
+            }
+        }
+
+        void AnswerAll()
+        {
+            TArray<FHttpResultCallback> ToAnswer = MoveTemp(Held);
+            Held.Reset();
+            for (const FHttpResultCallback& OnComplete : ToAnswer)
+            {
+                OnComplete(FHttpServerResponse::Create(TEXT("{\"success\":true}"), TEXT("application/json")));
+            }
+        }
+    };
+
+    // Ticks the server and the HTTP manager the way the engine loop would, until Done or a timeout
+    bool PumpUntil(TFunctionRef<bool()> Done, TFunctionRef<void()> EachTick)
+    {
+        const double Deadline = FPlatformTime::Seconds() + 10.0;
+        while (!Done() && FPlatformTime::Seconds() < Deadline)
+        {
+            FTSTicker::GetCoreTicker().Tick(0.01f);
+            FHttpModule::Get().GetHttpManager().Tick(0.01f);
+            EachTick();
+            FPlatformProcess::Sleep(0.005f);
+        }
+        return Done();
+    }
+
+    void SubmitStubRequest(FInterverseHttpDispatcher& Dispatcher, const FString& Verb, const FString& Id, EInterverseRequestPriority Priority, const UObject* Owner, TMap<FString, bool>& Results)
+    {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Dispatcher.CreateRequest(Verb, FString::Printf(TEXT("stub?id=%s"), *Id));
+        Request->OnProcessRequestComplete().BindLambda([&Results, Id](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+        {
+            Results.Add(Id, bSucceeded && Response.IsValid() && Response->GetResponseCode() == 200);
+        });
+        Dispatcher.Submit(Request, Priority, Owner);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseHttpDispatcherTest, "Interverse.Http.Dispatcher",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseHttpDispatcherTest::RunTest(const FString& Parameters)
+{
+    const FString NodeUrl = FString::Printf(TEXT("http://localhost:%u"), StubServerPort);
+    const FString ApiKey = TEXT("test-key");
+
+    // Trailing slashes name the same node, so they share one concurrency window
+    TSharedRef<FInterverseHttpDispatcher> Dispatcher = FInterverseHttpDispatcher::Acquire(NodeUrl, ApiKey);
+    TestTrue(TEXT("Trailing slash shares the dispatcher"), FInterverseHttpDispatcher::Acquire(NodeUrl + TEXT("/"), ApiKey) == Dispatcher);
+    TestFalse(TEXT("Another key gets its own dispatcher"), FInterverseHttpDispatcher::Acquire(NodeUrl, TEXT("other-key")) == Dispatcher);
+
+    Dispatcher->Configure(NodeUrl + TEXT("/"), ApiKey, 2);
+    TestTrue(TEXT("Configuration ignores trailing slashes"), Dispatcher->IsConfiguredFor(NodeUrl, ApiKey));
+
+    FStubNode Node;
+    if (!TestTrue(TEXT("Stub node listens"), Node.Start()))
+    {
+        Node.Stop();
+        return false;
+    }
+
+    // Low-priority writes fill both slots; high-priority reads queued behind them go next
+    TMap<FString, bool> Results;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        SubmitStubRequest(*Dispatcher, TEXT("POST"), FString::Printf(TEXT("L%d"), Index), EInterverseRequestPriority::Low, nullptr, Results);
+    }
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        SubmitStubRequest(*Dispatcher, TEXT("GET"), FString::Printf(TEXT("H%d"), Index), EInterverseRequestPriority::High, nullptr, Results);
+    }
+    TestEqual(TEXT("Only the concurrency limit starts at once"), Dispatcher->GetStats().InFlight, 2);
+    TestEqual(TEXT("The rest wait in their lanes"), Dispatcher->GetStats().QueuedHigh + Dispatcher->GetStats().QueuedLow, 4);
+
+    const bool bAllDone = PumpUntil([&Results]() { return Results.Num() == 6; }, [&Node]() { Node.AnswerAll(); });
+    TestTrue(TEXT("Every request completes"), bAllDone);
+    TestEqual(TEXT("Every request succeeds"), Algo::CountIf(Results, [](const TPair<FString, bool>& Result) { return Result.Value; }), 6);
+    TestTrue(TEXT("The node never sees more than the limit at once"), Node.MostHeld <= 2);
+
+    // Requests started together travel on separate connections, so only the lane order is fixed
+    const int32 LastLowArrival = Node.Arrivals.IndexOfByKey(TEXT("L2"));
+    bool bHighFirst = LastLowArrival != INDEX_NONE;
+    for (const TCHAR* Id : { TEXT("H0"), TEXT("H1"), TEXT("H2") })
+    {
+        const int32 Arrival = Node.Arrivals.IndexOfByKey(Id);
+        bHighFirst &= Arrival != INDEX_NONE && Arrival < LastLowArrival;
+    }
+    TestTrue(TEXT("Queued high-priority requests overtake queued low-priority ones"), bHighFirst);
+    TestEqual(TEXT("Peak queue depth"), Dispatcher->GetStats().PeakQueueDepth, 4);
+
+    // A departing owner's queued read fails at once and its queued write goes out past the limit
+    Dispatcher->Configure(NodeUrl, ApiKey, 1);
+    const UObject* Owner = GetTransientPackage();
+    Results.Reset();
+    Node.Arrivals.Reset();
+    SubmitStubRequest(*Dispatcher, TEXT("GET"), TEXT("Busy"), EInterverseRequestPriority::Normal, nullptr, Results);
+    SubmitStubRequest(*Dispatcher, TEXT("GET"), TEXT("OwnedRead"), EInterverseRequestPriority::Normal, Owner, Results);
+    SubmitStubRequest(*Dispatcher, TEXT("POST"), TEXT("OwnedWrite"), EInterverseRequestPriority::Low, Owner, Results);
+
+    Dispatcher->ReleaseOwner(Owner);
+    TestTrue(TEXT("Owned read fails through its delegate"), Results.Contains(TEXT("OwnedRead")) && !Results[TEXT("OwnedRead")]);
+    TestEqual(TEXT("Owned write starts alongside the busy request"), Dispatcher->GetStats().InFlight, 2);
+
+    TestTrue(TEXT("Released requests complete"), PumpUntil([&Results]() { return Results.Num() == 3; }, [&Node]() { Node.AnswerAll(); }));
+    TestTrue(TEXT("Owned write reaches the node"), Node.Arrivals.Contains(TEXT("OwnedWrite")) && Results.FindRef(TEXT("OwnedWrite")));
+    TestFalse(TEXT("Owned read never reaches the node"), Node.Arrivals.Contains(TEXT("OwnedRead")));
+
+    const FInterverseHttpStats& Stats = Dispatcher->GetStats();
+    AddInfo(FString::Printf(TEXT("Completed %d, failed %d, average wait %.2f ms, average latency %.2f ms"),
+        Stats.Completed, Stats.Failed, Stats.AverageQueueWaitMs, Stats.AverageLatencyMs));
+
+    Node.Stop();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,293 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseInventoryComponent.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Misc/SecureHash.h"
+#include "Async/TaskGraphInterfaces.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr int32 NumTestOwners = 16;
+    constexpr int32 NumTestCategories = 8;
+
+    FInterverseAsset MakeTestAsset(int32 Index)
+    {
+        FInterverseAsset Asset;
+        Asset.AssetId = FString::Printf(TEXT("Asset_%d"), Index);
+        Asset.Category = static_cast<EInterverseItemCategory>(Index % NumTestCategories);
+        return Asset;
+    }
+
+    FString GetTestOwner(int32 Index)
+    {
+        return FString::Printf(TEXT("Player_%d"), Index % NumTestOwners);
+    }
+
+    FInterverseAsset MakeWalletAsset(int32 Index, const FString& Wallet)
+    {
+        FInterverseAsset Asset = MakeTestAsset(Index);
+        Asset.Owner = Wallet;
+        Asset.OwnerGlobalID = GetTestOwner(Index);
+        Asset.AssetType = EInterverseAssetType::WEAPON;
+        Asset.Rarity = EInterverseRarity::Common;
+        Asset.Metadata.Add(TEXT("Level"), FString::FromInt(Index % 50));
+        return Asset;
+    }
+
+    // Same slot naming as the inventory component
+    FString GetCacheSlotName(const FString& WalletAddress)
+    {
+        return FString::Printf(TEXT("InterverseAssets_%s"), *FMD5::HashAnsiString(*WalletAddress));
+    }
+
+    // The cache is written on a worker; wait until the slot holds the whole file
+    bool WaitForCacheSlot(const FString& WalletAddress, int32 ExpectedBytes)
+    {
+        ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+        const FString SlotName = GetCacheSlotName(WalletAddress);
+        const double Deadline = FPlatformTime::Seconds() + 10.0;
+        while (SaveSystem && FPlatformTime::Seconds() < Deadline)
+        {
+            TArray<uint8> Bytes;
+            if (SaveSystem->DoesSaveGameExist(*SlotName, 0) && SaveSystem->LoadGame(false, *SlotName, 0, Bytes) && Bytes.Num() == ExpectedBytes)
+            {
+                return true;
+            }
+            FPlatformProcess::Sleep(0.005f);
+        }
+        return false;
+    }
+
+    // Runs the game-thread tasks a cache load posts back, until Done or a timeout
+    bool PumpGameThreadUntil(TFunctionRef<bool()> Done)
+    {
+        const double Deadline = FPlatformTime::Seconds() + 10.0;
+        while (!Done() && FPlatformTime::Seconds() < Deadline)
+        {
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+            FPlatformProcess::Sleep(0.005f);
+        }
+        return Done();
+    }
+
+    bool RunInventoryIndexTest(FAutomationTestBase& Test, int32 NumItems)
+    {
+        UInterverseInventoryComponent* Inventory = NewObject<UInterverseInventoryComponent>();
+
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumItems; ++Index)
+        {
+            Inventory->AddItemToPlayerInventory(MakeTestAsset(Index), GetTestOwner(Index));
+        }
+        const double AddMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        Test.TestEqual(TEXT("Inventory size"), Inventory->GetInventorySize(), NumItems);
+        Test.TestFalse(TEXT("Duplicate asset id is rejected"), Inventory->AddItem(MakeTestAsset(0)));
+
+        StartTime = FPlatformTime::Seconds();
+        int32 Found = 0;
+        for (int32 Index = 0; Index < NumItems; ++Index)
+        {
+            const FInterverseInventoryItem* Item = Inventory->FindItem(FString::Printf(TEXT("Asset_%d"), Index));
+            if (Item && Item->Slot == Index)
+            {
+                ++Found;
+            }
+        }
+        const double LookupMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        Test.TestEqual(TEXT("Every item is found at its slot"), Found, NumItems);
+
+        StartTime = FPlatformTime::Seconds();
+        int32 Owned = 0;
+        for (int32 Owner = 0; Owner < NumTestOwners; ++Owner)
+        {
+            Owned += Inventory->GetPlayerItemIndices(GetTestOwner(Owner)).Num();
+        }
+        const double OwnerQueryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        Test.TestEqual(TEXT("Owner index covers every item"), Owned, NumItems);
+
+        // Removal keeps the order of what remains
+        const int32 NumRemoved = FMath::Min(NumItems / 2, 100);
+        for (int32 Index = 0; Index < NumRemoved; ++Index)
+        {
+            Inventory->RemoveItem(FString::Printf(TEXT("Asset_%d"), Index * 2));
+        }
+        Test.TestEqual(TEXT("Size after removal"), Inventory->GetInventorySize(), NumItems - NumRemoved);
+        Test.TestFalse(TEXT("Removed item is gone"), Inventory->HasItem(TEXT("Asset_0")));
+        Test.TestEqual(TEXT("First remaining item"), Inventory->Items[0].Asset.AssetId, FString(TEXT("Asset_1")));
+
+        const TConstArrayView<int32> FirstOwnerItems = Inventory->GetPlayerItemIndices(GetTestOwner(1));
+        bool bOrdered = true;
+        for (int32 Position = 1; Position < FirstOwnerItems.Num(); ++Position)
+        {
+            bOrdered &= FirstOwnerItems[Position - 1] < FirstOwnerItems[Position];
+        }
+        Test.TestTrue(TEXT("Owner query returns items in inventory order"), bOrdered);
+
+        // A same-size edit from outside must not leave lookups pointing at the wrong slot
+        const int32 Last = Inventory->Items.Num() - 1;
+        const FString FirstId = Inventory->Items[0].Asset.AssetId;
+        const FString LastId = Inventory->Items[Last].Asset.AssetId;
+        Inventory->Items.Swap(0, Last);
+
+        const FInterverseInventoryItem* Swapped = Inventory->FindItem(FirstId);
+        Test.TestTrue(TEXT("Lookup follows an in-place swap"), Swapped && Swapped == &Inventory->Items[Last]);
+        Test.TestTrue(TEXT("Remove acts on the right item after a swap"), Inventory->RemoveItem(LastId) && Inventory->HasItem(FirstId));
+
+        Test.AddInfo(FString::Printf(TEXT("%d items: add %.2f ms, %d lookups %.2f ms, owner queries %.3f ms"),
+            NumItems, AddMs, NumItems, LookupMs, OwnerQueryMs));
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseInventoryIndexTest, "Interverse.Inventory.Index",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseInventoryIndexTest::RunTest(const FString& Parameters)
+{
+    for (int32 NumItems : { 1000, 10000, 100000 })
+    {
+        RunInventoryIndexTest(*this, NumItems);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseInventoryFillReuseTest, "Interverse.Inventory.FillReuse",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseInventoryFillReuseTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumItems = 1000;
+    constexpr int32 NumCalls = 100;
+
+    UInterverseInventoryComponent* Inventory = NewObject<UInterverseInventoryComponent>();
+    for (int32 Index = 0; Index < NumItems; ++Index)
+    {
+        Inventory->AddItemToPlayerInventory(MakeTestAsset(Index), GetTestOwner(Index));
+    }
+
+    // The first call sizes the buffer; every later, smaller one has to fit in it
+    TArray<FInterverseInventoryItem> OutItems;
+    Inventory->FillItemsByCategory(static_cast<EInterverseItemCategory>(0), OutItems);
+    TestEqual(TEXT("First fill returns the category's items"), OutItems.Num(), Inventory->GetCategoryItemIndices(static_cast<EInterverseItemCategory>(0)).Num());
+
+    const FInterverseInventoryItem* const Buffer = OutItems.GetData();
+    const int32 Capacity = OutItems.Max();
+    int32 Reallocations = 0;
+    for (int32 Call = 0; Call < NumCalls; ++Call)
+    {
+        Inventory->FillPlayerItems(GetTestOwner(Call), OutItems);
+        Reallocations += OutItems.GetData() != Buffer || OutItems.Max() != Capacity ? 1 : 0;
+    }
+    TestEqual(TEXT("Player fills return the player's items"), OutItems.Num(), Inventory->GetPlayerItemIndices(GetTestOwner(NumCalls - 1)).Num());
+    TestEqual(TEXT("FillPlayerItems reuses the caller's buffer"), Reallocations, 0);
+
+    // Going back to the larger result still fits without growing
+    Inventory->FillItemsByCategory(static_cast<EInterverseItemCategory>(0), OutItems);
+    TestTrue(TEXT("Mixed fills keep the buffer"), OutItems.GetData() == Buffer && OutItems.Max() == Capacity);
+
+    // Views point into the index itself rather than into a copy
+    const TConstArrayView<int32> FirstView = Inventory->GetPlayerItemIndices(GetTestOwner(2));
+    int32 MovedViews = 0;
+    for (int32 Call = 0; Call < NumCalls; ++Call)
+    {
+        const TConstArrayView<int32> View = Inventory->GetPlayerItemIndices(GetTestOwner(2));
+        MovedViews += View.GetData() != FirstView.GetData() || View.Num() != FirstView.Num() ? 1 : 0;
+    }
+    TestEqual(TEXT("GetPlayerItemIndices returns the same storage every call"), MovedViews, 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseInventoryCacheTest, "Interverse.Inventory.Cache",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseInventoryCacheTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumCached = 500;
+    const FString Wallet = FString::Printf(TEXT("0xCacheTest_%s"), *FGuid::NewGuid().ToString());
+
+    // Only the wallet's own assets go into its cache
+    TArray<FInterverseAsset> ChainAssets;
+    UInterverseInventoryComponent* Source = NewObject<UInterverseInventoryComponent>();
+    for (int32 Index = 0; Index < NumCached; ++Index)
+    {
+        ChainAssets.Add(MakeWalletAsset(Index, Wallet));
+        Source->AddItemToPlayerInventory(ChainAssets.Last(), ChainAssets.Last().OwnerGlobalID);
+    }
+    for (int32 Index = NumCached; Index < NumCached + 20; ++Index)
+    {
+        const FInterverseAsset Asset = MakeWalletAsset(Index, TEXT("0xSomeoneElse"));
+        Source->AddItemToPlayerInventory(Asset, Asset.OwnerGlobalID);
+    }
+
+    Source->SaveInventoryCache(Wallet);
+    const int32 BytesWritten = Source->GetCacheStats().BytesWritten;
+    if (!TestTrue(TEXT("Cache slot is written"), BytesWritten > 0 && WaitForCacheSlot(Wallet, BytesWritten)))
+    {
+        return false;
+    }
+
+    // A fresh session is playable from the cache alone
+    UInterverseInventoryComponent* Inventory = NewObject<UInterverseInventoryComponent>();
+    Inventory->LoadCachedInventory(Wallet);
+    TestTrue(TEXT("Cached items arrive"), PumpGameThreadUntil([Inventory]() { return Inventory->GetCacheStats().ItemsLoaded > 0; }));
+
+    const FInterverseInventoryCacheStats LoadStats = Inventory->GetCacheStats();
+    TestEqual(TEXT("Every cached item is loaded"), LoadStats.ItemsLoaded, NumCached);
+    TestEqual(TEXT("Other wallets' items are not cached"), Inventory->GetInventorySize(), NumCached);
+    TestEqual(TEXT("The whole file is read"), LoadStats.BytesRead, BytesWritten);
+
+    int32 Mismatches = 0;
+    for (const FInterverseAsset& Asset : ChainAssets)
+    {
+        const FInterverseInventoryItem* Item = Inventory->FindItem(Asset.AssetId);
+        Mismatches += Item && Item->OwnerGlobalID == Asset.OwnerGlobalID && Item->Asset.Metadata.OrderIndependentCompareEqual(Asset.Metadata) ? 0 : 1;
+    }
+    TestEqual(TEXT("Cached items match what was saved"), Mismatches, 0);
+
+    // The node reports exactly what was cached: the hash matches and nothing is touched or rewritten
+    Inventory->ApplyChainAssets(Wallet, ChainAssets);
+    FInterverseInventoryCacheStats Stats = Inventory->GetCacheStats();
+    TestTrue(TEXT("Unchanged chain state is recognised by its hash"), Stats.bCacheWasCurrent);
+    TestEqual(TEXT("Skipped reconcile applies nothing"), Stats.ReconcileAdded + Stats.ReconcileRemoved + Stats.ReconcileChanged, 0);
+    TestEqual(TEXT("Skipped reconcile does not rewrite the cache"), Stats.BytesWritten, 0);
+
+    // One asset gone, one changed, one new: only those are applied
+    const FString GoneId = ChainAssets[0].AssetId;
+    ChainAssets.RemoveAt(0);
+    ChainAssets[0].Metadata.Add(TEXT("Level"), TEXT("99"));
+    FInterverseAsset Minted = MakeWalletAsset(NumCached + 100, Wallet);
+    Minted.OwnerGlobalID = TEXT("Player_Minted");
+    ChainAssets.Add(Minted);
+
+    Inventory->ApplyChainAssets(Wallet, ChainAssets);
+    Stats = Inventory->GetCacheStats();
+    TestFalse(TEXT("Changed chain state misses the hash"), Stats.bCacheWasCurrent);
+    TestEqual(TEXT("Reconcile adds the new asset"), Stats.ReconcileAdded, 1);
+    TestEqual(TEXT("Reconcile removes the gone asset"), Stats.ReconcileRemoved, 1);
+    TestEqual(TEXT("Reconcile updates the changed asset"), Stats.ReconcileChanged, 1);
+    TestFalse(TEXT("Gone asset is removed"), Inventory->HasItem(GoneId));
+    const FInterverseInventoryItem* Changed = Inventory->FindItem(ChainAssets[0].AssetId);
+    TestTrue(TEXT("Changed asset is updated"), Changed && Changed->Asset.Metadata.FindRef(TEXT("Level")) == TEXT("99"));
+
+    const FInterverseInventoryItem* Added = Inventory->FindItem(Minted.AssetId);
+    TestTrue(TEXT("New asset keeps its player"), Added && Added->OwnerGlobalID == Minted.OwnerGlobalID);
+    TestEqual(TEXT("New asset is in its player's items"), Inventory->GetPlayerItemIndices(Minted.OwnerGlobalID).Num(), 1);
+
+    // The reconcile refreshed the cache, so the next identical answer is skipped again
+    Inventory->ApplyChainAssets(Wallet, ChainAssets);
+    TestTrue(TEXT("Refreshed cache hash matches the chain"), Inventory->GetCacheStats().bCacheWasCurrent);
+
+    AddInfo(FString::Printf(TEXT("%d cached items: %d bytes read, interactive after %.2f ms"),
+        LoadStats.ItemsLoaded, LoadStats.BytesRead, LoadStats.LoadMs));
+
+    if (WaitForCacheSlot(Wallet, Inventory->GetCacheStats().BytesWritten))
+    {
+        IPlatformFeaturesModule::Get().GetSaveGameSystem()->DeleteGame(false, *GetCacheSlotName(Wallet), 0);
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
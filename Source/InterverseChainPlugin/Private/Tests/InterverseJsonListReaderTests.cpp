@@ -0,0 +1,107 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseJsonListReader.h"
+#include "InterverseCompatibility.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // A node's asset list reply with Count items, each about the size of a real asset
+    FString MakeAssetListBody(int32 Count)
+    {
+        FString Body;
+        Body.Reserve(Count * 200);
+        Body += TEXT("{\"success\":true,\"data\":[");
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            if (Index > 0)
+            {
+                Body += TEXT(",");
+            }
+            Body += FString::Printf(
+                TEXT("{\"asset_id\":\"Asset_%d\",\"owner\":\"0xWallet_%d\",\"category\":\"%s\",")
+                TEXT("\"metadata\":{\"Damage\":\"%d\",\"Name\":\"Blade \\\"%d\\\"\",\"Origin\":\"Interverse\"}}"),
+                Index, Index % 16, Index % 2 == 0 ? TEXT("WEAPON") : TEXT("ARMOR"), Index % 100, Index);
+        }
+        Body += TEXT("]}");
+        return Body;
+    }
+
+    bool ReadAssetsWithDom(const FString& Content, TArray<FInterverseAsset>& OutAssets)
+    {
+        TSharedPtr<FJsonObject> JsonObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+        const TArray<TSharedPtr<FJsonValue>>* AssetArray = nullptr;
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() || !JsonObject->TryGetArrayField(TEXT("data"), AssetArray))
+        {
+            return false;
+        }
+
+        OutAssets.Reserve(AssetArray->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *AssetArray)
+        {
+            const TSharedPtr<FJsonObject>* AssetObject;
+            FInterverseAsset Asset;
+            if (Value.IsValid() && Value->TryGetObject(AssetObject) && InterverseCompat::ConvertJsonToAsset(*AssetObject, Asset))
+            {
+                OutAssets.Add(MoveTemp(Asset));
+            }
+        }
+        return true;
+    }
+
+    bool AssetsMatch(const FInterverseAsset& A, const FInterverseAsset& B)
+    {
+        return A.AssetId == B.AssetId && A.Owner == B.Owner && A.Category == B.Category && A.Metadata.OrderIndependentCompareEqual(B.Metadata);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseJsonListReaderTest, "Interverse.Json.ListReader",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseJsonListReaderTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumItems = 10000;
+    constexpr int32 ChunkSize = 256;
+    const FString Body = MakeAssetListBody(NumItems);
+
+    double StartTime = FPlatformTime::Seconds();
+    TArray<FInterverseAsset> DomAssets;
+    TestTrue(TEXT("DOM parse succeeds"), ReadAssetsWithDom(Body, DomAssets));
+    const double DomMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    TArray<FInterverseAsset> StreamedAssets;
+    int32 NumChunks = 0;
+    int32 LargestChunk = 0;
+    const bool bStreamed = FInterverseJsonListReader::ReadAssets(Body, ChunkSize, [&](TArray<FInterverseAsset>&& Chunk)
+    {
+        ++NumChunks;
+        LargestChunk = FMath::Max(LargestChunk, Chunk.Num());
+        StreamedAssets.Append(MoveTemp(Chunk));
+    });
+    const double StreamMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TestTrue(TEXT("Streaming read succeeds"), bStreamed);
+    TestEqual(TEXT("Both readers find every item"), StreamedAssets.Num(), DomAssets.Num());
+    TestEqual(TEXT("Item count"), StreamedAssets.Num(), NumItems);
+    TestTrue(TEXT("Chunks respect the chunk size"), LargestChunk <= ChunkSize && NumChunks == FMath::DivideAndRoundUp(NumItems, ChunkSize));
+
+    int32 Mismatches = 0;
+    for (int32 Index = 0; Index < FMath::Min(StreamedAssets.Num(), DomAssets.Num()); ++Index)
+    {
+        Mismatches += AssetsMatch(StreamedAssets[Index], DomAssets[Index]) ? 0 : 1;
+    }
+    TestEqual(TEXT("Streaming gives the same items in the same order as the DOM"), Mismatches, 0);
+
+    // A body cut short must fail rather than report a partial list as complete
+    TestFalse(TEXT("Truncated body is rejected"), FInterverseJsonListReader::ReadAssets(Body.LeftChop(Body.Len() / 2), ChunkSize, [](TArray<FInterverseAsset>&&) {}));
+
+    AddInfo(FString::Printf(TEXT("%d items, %d KB: DOM %.2f ms, streaming %.2f ms in %d chunks"),
+        NumItems, Body.Len() / 1024, DomMs, StreamMs, NumChunks));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
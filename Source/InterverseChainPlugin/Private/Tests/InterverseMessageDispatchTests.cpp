@@ -0,0 +1,98 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseChainComponent.h"
+#include "InterverseConnectionManager.h"
+#include "InterverseMessageRegistry.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    const FName TestGameType(TEXT("interverse_test_quest_done"));
+
+    // One of each frame a node can send, plus the malformed and unknown ones that must be dropped
+    const TCHAR* const MixedFrames[] = {
+        TEXT("{\"type\":\"asset_update\",\"asset\":{\"asset_id\":\"Sword_1\",\"owner\":\"0xA\",\"category\":\"WEAPON\"}}"),
+        TEXT("{\"type\":\"asset_minted\",\"asset\":{\"asset_id\":\"Sword_2\",\"owner\":\"0xA\",\"category\":\"WEAPON\"}}"),
+        TEXT("{\"type\":\"asset_minted\",\"data\":{\"asset_id\":\"Shield_3\",\"owner\":\"0xB\",\"category\":\"ARMOR\"}}"),
+        TEXT("{\"type\":\"asset_minted\",\"data\":{\"asset_id\":\"\",\"owner\":\"0xA\",\"category\":\"WEAPON\"}}"),
+        TEXT("{\"type\":\"asset_minted\"}"),
+        TEXT("{\"type\":\"balance_update\",\"data\":{\"address\":\"0xA\",\"balance\":12.5}}"),
+        TEXT("{\"type\":\"transfer_complete\",\"data\":{\"asset_id\":\"Sword_1\",\"success\":true}}"),
+        TEXT("{\"type\":\"interverse_test_quest_done\",\"quest\":\"Q7\"}"),
+        TEXT("{\"type\":\"interverse_test_never_registered\",\"value\":1}"),
+        TEXT("not json")
+    };
+    constexpr int32 NumMixedFrames = UE_ARRAY_COUNT(MixedFrames);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseMessageDispatchTest, "Interverse.Messages.Dispatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseMessageDispatchTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumPasses = 2000;
+
+    UInterverseChainComponent* Component = NewObject<UInterverseChainComponent>();
+
+    // Counting handlers in place of the built-in ones, so the test sees exactly what gets dispatched
+    TMap<FName, int32> Handled;
+    TArray<FString> MintedIds;
+    for (const FName& Type : { InterverseMessageTypes::AssetUpdate, InterverseMessageTypes::AssetMinted, InterverseMessageTypes::BalanceUpdate, InterverseMessageTypes::TransferComplete, TestGameType })
+    {
+        Component->RegisterMessageHandler(Type, [&Handled, &MintedIds, Type](const FInterverseDecodedPayload& Payload)
+        {
+            Handled.FindOrAdd(Type)++;
+            if (Type == InterverseMessageTypes::AssetMinted)
+            {
+                MintedIds.Add(Payload.Asset.AssetId);
+            }
+        });
+    }
+
+    TArray<FInterverseDecodedPayload> Payloads;
+    Payloads.SetNum(NumMixedFrames);
+    for (int32 Index = 0; Index < NumMixedFrames; ++Index)
+    {
+        FInterverseConnectionManager::DecodeMessage(MixedFrames[Index], Payloads[Index]);
+        Component->ApplyDecodedPayload(Payloads[Index]);
+    }
+
+    TestEqual(TEXT("asset_update dispatched"), Handled.FindRef(InterverseMessageTypes::AssetUpdate), 1);
+    TestEqual(TEXT("Only asset_minted frames with an asset are dispatched"), Handled.FindRef(InterverseMessageTypes::AssetMinted), 2);
+    TestEqual(TEXT("Minted assets keep their ids"), MintedIds, TArray<FString>({ TEXT("Sword_2"), TEXT("Shield_3") }));
+    TestEqual(TEXT("balance_update dispatched"), Handled.FindRef(InterverseMessageTypes::BalanceUpdate), 1);
+    TestEqual(TEXT("transfer_complete dispatched"), Handled.FindRef(InterverseMessageTypes::TransferComplete), 1);
+    TestEqual(TEXT("Game type without a decoder arrives with its JSON"), Handled.FindRef(TestGameType), 1);
+    TestTrue(TEXT("Game type keeps its fields"), Payloads[7].Json.IsValid() && Payloads[7].Json->GetStringField(TEXT("quest")) == TEXT("Q7"));
+    TestTrue(TEXT("Unregistered type resolves to no name"), Payloads[8].Type.IsNone() && !Payloads[8].bValid);
+    TestFalse(TEXT("Malformed frame is dropped"), Payloads[9].bValid);
+
+    // Microbenchmark: decoding and dispatch over the same mixed stream, repeated
+    double DecodeMs = 0.0;
+    double DispatchMs = 0.0;
+    for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumMixedFrames; ++Index)
+        {
+            Payloads[Index] = FInterverseDecodedPayload();
+            FInterverseConnectionManager::DecodeMessage(MixedFrames[Index], Payloads[Index]);
+        }
+        DecodeMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        StartTime = FPlatformTime::Seconds();
+        for (const FInterverseDecodedPayload& Payload : Payloads)
+        {
+            Component->ApplyDecodedPayload(Payload);
+        }
+        DispatchMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    }
+    TestEqual(TEXT("Every pass dispatches the same frames"), Handled.FindRef(InterverseMessageTypes::AssetMinted), 2 * (NumPasses + 1));
+
+    const int32 NumMessages = NumPasses * NumMixedFrames;
+    AddInfo(FString::Printf(TEXT("%d messages: decode %.3f us/msg, dispatch %.3f us/msg on the game thread"),
+        NumMessages, DecodeMs * 1000.0 / NumMessages, DispatchMs * 1000.0 / NumMessages));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
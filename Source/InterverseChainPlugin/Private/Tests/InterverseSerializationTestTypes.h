@@ -0,0 +1,267 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPtr.h"
+#include "InterverseStandardTypes.h"
+#include "InterverseSerializationTestTypes.generated.h"
+
+// SaveGame properties of every kind FInterverseSerializationPlan has to carry; only used by automation tests
+UCLASS(Transient, NotBlueprintable)
+class UInterverseSerializationTestObject : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(SaveGame)
+    int32 Level = 0;
+
+    UPROPERTY(SaveGame)
+    float Health = 0.0f;
+
+    UPROPERTY(SaveGame)
+    FString DisplayName;
+
+    UPROPERTY(SaveGame)
+    FName Tag;
+
+    UPROPERTY(SaveGame)
+    EInterverseRarity Rarity = EInterverseRarity::Common;
+
+    UPROPERTY(SaveGame)
+    FVector Location = FVector::ZeroVector;
+
+    UPROPERTY(SaveGame)
+    FLinearColor Color = FLinearColor(ForceInit);
+
+    UPROPERTY(SaveGame)
+    TArray<int32> Numbers;
+
+    UPROPERTY(SaveGame)
+    TMap<FString, float> Stats;
+
+    UPROPERTY(SaveGame)
+    TObjectPtr<UObject> Reference;
+
+    UPROPERTY(SaveGame)
+    TSoftObjectPtr<UObject> SoftReference;
+
+    // Not SaveGame, so never transferred
+    UPROPERTY()
+    int32 LocalOnly = 0;
+};
+
+// Same property names as UInterverseSerializationTestObject, but Numbers holds floats
+UCLASS(Transient, NotBlueprintable)
+class UInterverseSerializationTestVariant : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(SaveGame)
+    int32 Level = 0;
+
+    UPROPERTY(SaveGame)
+    TArray<float> Numbers;
+};
+
+// Many flat SaveGame properties among non-SaveGame ones, for timing plan lookups against a per-call walk
+UCLASS(Transient, NotBlueprintable)
+class UInterverseSerializationWideObject : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(SaveGame)
+    int32 Count00 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count01 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count02 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count03 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count04 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count05 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count06 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count07 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count08 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count09 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count10 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count11 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count12 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count13 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count14 = 0;
+
+    UPROPERTY(SaveGame)
+    int32 Count15 = 0;
+
+    UPROPERTY(SaveGame)
+    float Scale00 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale01 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale02 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale03 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale04 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale05 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale06 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale07 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale08 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale09 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale10 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale11 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale12 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale13 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale14 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    float Scale15 = 0.0f;
+
+    UPROPERTY(SaveGame)
+    FString Label00;
+
+    UPROPERTY(SaveGame)
+    FString Label01;
+
+    UPROPERTY(SaveGame)
+    FString Label02;
+
+    UPROPERTY(SaveGame)
+    FString Label03;
+
+    UPROPERTY(SaveGame)
+    FString Label04;
+
+    UPROPERTY(SaveGame)
+    FString Label05;
+
+    UPROPERTY(SaveGame)
+    FString Label06;
+
+    UPROPERTY(SaveGame)
+    FString Label07;
+
+    UPROPERTY(SaveGame)
+    FString Label08;
+
+    UPROPERTY(SaveGame)
+    FString Label09;
+
+    UPROPERTY(SaveGame)
+    FString Label10;
+
+    UPROPERTY(SaveGame)
+    FString Label11;
+
+    UPROPERTY(SaveGame)
+    FString Label12;
+
+    UPROPERTY(SaveGame)
+    FString Label13;
+
+    UPROPERTY(SaveGame)
+    FString Label14;
+
+    UPROPERTY(SaveGame)
+    FString Label15;
+
+    // Not SaveGame; the per-call walk still has to step over these
+    UPROPERTY()
+    int32 Local00 = 0;
+
+    UPROPERTY()
+    int32 Local01 = 0;
+
+    UPROPERTY()
+    int32 Local02 = 0;
+
+    UPROPERTY()
+    int32 Local03 = 0;
+
+    UPROPERTY()
+    int32 Local04 = 0;
+
+    UPROPERTY()
+    int32 Local05 = 0;
+
+    UPROPERTY()
+    int32 Local06 = 0;
+
+    UPROPERTY()
+    int32 Local07 = 0;
+
+    UPROPERTY()
+    int32 Local08 = 0;
+
+    UPROPERTY()
+    int32 Local09 = 0;
+
+    UPROPERTY()
+    int32 Local10 = 0;
+
+    UPROPERTY()
+    int32 Local11 = 0;
+
+    UPROPERTY()
+    int32 Local12 = 0;
+
+    UPROPERTY()
+    int32 Local13 = 0;
+
+    UPROPERTY()
+    int32 Local14 = 0;
+
+    UPROPERTY()
+    int32 Local15 = 0;
+};
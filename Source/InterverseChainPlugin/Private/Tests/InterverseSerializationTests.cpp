@@ -0,0 +1,211 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseSerializationPlan.h"
+#include "InterverseSerializationTestTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    UInterverseSerializationTestObject* MakeTestSource(UObject* Reference)
+    {
+        UInterverseSerializationTestObject* Source = NewObject<UInterverseSerializationTestObject>();
+        Source->Level = 42;
+        Source->Health = 87.5f;
+        Source->DisplayName = TEXT("Knight \"of\" the Realm");
+        Source->Tag = TEXT("Elite");
+        Source->Rarity = EInterverseRarity::Epic;
+        Source->Location = FVector(1.0, -2.5, 300.0);
+        Source->Color = FLinearColor(0.25f, 0.5f, 0.75f, 1.0f);
+        Source->Numbers = { 1, -2, 3, 100000 };
+        Source->Stats.Add(TEXT("Strength"), 12.0f);
+        Source->Stats.Add(TEXT("Agility"), 7.5f);
+        Source->Reference = Reference;
+        Source->SoftReference = Reference;
+        Source->LocalOnly = 5;
+        return Source;
+    }
+
+    void TestMatches(FAutomationTestBase& Test, const TCHAR* Format, const UInterverseSerializationTestObject* Source, const UInterverseSerializationTestObject* Target)
+    {
+        Test.TestEqual(FString::Printf(TEXT("%s: int"), Format), Target->Level, Source->Level);
+        Test.TestEqual(FString::Printf(TEXT("%s: float"), Format), Target->Health, Source->Health);
+        Test.TestEqual(FString::Printf(TEXT("%s: string"), Format), Target->DisplayName, Source->DisplayName);
+        Test.TestTrue(FString::Printf(TEXT("%s: name"), Format), Target->Tag == Source->Tag);
+        Test.TestTrue(FString::Printf(TEXT("%s: enum"), Format), Target->Rarity == Source->Rarity);
+        Test.TestEqual(FString::Printf(TEXT("%s: vector"), Format), Target->Location, Source->Location);
+        Test.TestEqual(FString::Printf(TEXT("%s: color"), Format), Target->Color, Source->Color);
+        Test.TestEqual(FString::Printf(TEXT("%s: array"), Format), Target->Numbers, Source->Numbers);
+        Test.TestTrue(FString::Printf(TEXT("%s: map"), Format), Target->Stats.OrderIndependentCompareEqual(Source->Stats));
+        Test.TestTrue(FString::Printf(TEXT("%s: object reference"), Format), Target->Reference == Source->Reference);
+        Test.TestTrue(FString::Printf(TEXT("%s: soft reference"), Format), Target->SoftReference.ToSoftObjectPath() == Source->SoftReference.ToSoftObjectPath());
+        Test.TestEqual(FString::Printf(TEXT("%s: non-SaveGame property untouched"), Format), Target->LocalOnly, 0);
+    }
+
+    // Gives each SaveGame property of the wide class its own value
+    UInterverseSerializationWideObject* MakeWideSource()
+    {
+        UInterverseSerializationWideObject* Source = NewObject<UInterverseSerializationWideObject>();
+        int32 Index = 0;
+        for (TFieldIterator<FProperty> PropIt(Source->GetClass()); PropIt; ++PropIt, ++Index)
+        {
+            void* Value = PropIt->ContainerPtrToValuePtr<void>(Source);
+            if (const FIntProperty* IntProperty = CastField<FIntProperty>(*PropIt))
+            {
+                IntProperty->SetPropertyValue(Value, Index * 7);
+            }
+            else if (const FFloatProperty* FloatProperty = CastField<FFloatProperty>(*PropIt))
+            {
+                FloatProperty->SetPropertyValue(Value, Index * 0.25f);
+            }
+            else if (const FStrProperty* StrProperty = CastField<FStrProperty>(*PropIt))
+            {
+                StrProperty->SetPropertyValue(Value, FString::Printf(TEXT("Label_%d"), Index));
+            }
+        }
+        return Source;
+    }
+
+    // What actor transfer did before plans: walk every field on each write and look each name up on each read
+    void WriteTextByWalk(UObject* Object, TMap<FString, FString>& OutValues)
+    {
+        for (TFieldIterator<FProperty> PropIt(Object->GetClass()); PropIt; ++PropIt)
+        {
+            FProperty* Property = *PropIt;
+            if (Property->HasAnyPropertyFlags(CPF_SaveGame))
+            {
+                FString ValueString;
+                const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
+                Property->ExportTextItem_Direct(ValueString, PropertyValue, PropertyValue, Object, PPF_None);
+                OutValues.Add(Property->GetName(), ValueString);
+            }
+        }
+    }
+
+    void ReadTextByWalk(UObject* Object, const TMap<FString, FString>& Values)
+    {
+        for (const TPair<FString, FString>& Pair : Values)
+        {
+            FProperty* Property = FindFProperty<FProperty>(Object->GetClass(), *Pair.Key);
+            if (Property && Property->HasAnyPropertyFlags(CPF_SaveGame))
+            {
+                Property->ImportText_Direct(*Pair.Value, Property->ContainerPtrToValuePtr<void>(Object), Object, PPF_None);
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseSerializationRoundTripTest, "Interverse.Serialization.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseSerializationRoundTripTest::RunTest(const FString& Parameters)
+{
+    UObject* Referenced = NewObject<UInterverseSerializationTestVariant>(GetTransientPackage());
+    const UInterverseSerializationTestObject* Source = MakeTestSource(Referenced);
+    const TSharedRef<const FInterverseSerializationPlan> Plan = FInterverseSerializationPlan::Get(Source->GetClass());
+
+    TestEqual(TEXT("Only SaveGame properties are planned"), Plan->GetProperties().Num(), 11);
+
+    // Binary
+    TArray<uint8> Bytes;
+    Plan->WriteBinary(const_cast<UInterverseSerializationTestObject*>(Source), Bytes);
+
+    UInterverseSerializationTestObject* BinaryTarget = NewObject<UInterverseSerializationTestObject>();
+    TArray<FSoftObjectPath> Unresolved;
+    TestTrue(TEXT("Binary read succeeds"), Plan->ReadBinary(BinaryTarget, Bytes, &Unresolved));
+    TestEqual(TEXT("Loaded references need no streaming"), Unresolved.Num(), 0);
+    TestMatches(*this, TEXT("Binary"), Source, BinaryTarget);
+
+    // Text
+    TMap<FString, FString> Values;
+    Plan->WriteText(const_cast<UInterverseSerializationTestObject*>(Source), Values);
+
+    UInterverseSerializationTestObject* TextTarget = NewObject<UInterverseSerializationTestObject>();
+    Plan->ReadText(TextTarget, Values);
+    TestMatches(*this, TEXT("Text"), Source, TextTarget);
+
+    // A container with the same name but a different element type is skipped, the rest still applies
+    UInterverseSerializationTestVariant* Variant = NewObject<UInterverseSerializationTestVariant>();
+    TestTrue(TEXT("Variant read succeeds"), FInterverseSerializationPlan::Get(Variant->GetClass())->ReadBinary(Variant, Bytes));
+    TestEqual(TEXT("Matching property is read"), Variant->Level, Source->Level);
+    TestEqual(TEXT("TArray<int32> is not read into TArray<float>"), Variant->Numbers.Num(), 0);
+
+    // A reference to an object that isn't in memory is reported instead of loaded
+    const FSoftObjectPath OldPath(Referenced);
+    Referenced->Rename(*MakeUniqueObjectName(GetTransientPackage(), Referenced->GetClass()).ToString(), nullptr, REN_DontCreateRedirectors | REN_NonTransactional);
+
+    UInterverseSerializationTestObject* MissingTarget = NewObject<UInterverseSerializationTestObject>();
+    Unresolved.Reset();
+    TestTrue(TEXT("Read with a missing reference succeeds"), Plan->ReadBinary(MissingTarget, Bytes, &Unresolved));
+    TestNull(TEXT("Missing reference is left null"), MissingTarget->Reference.Get());
+    TestTrue(TEXT("Missing reference is reported"), Unresolved.Contains(OldPath));
+    TestEqual(TEXT("Other values still apply"), MissingTarget->Level, Source->Level);
+
+    // Corrupt input is rejected without touching memory past the buffer
+    TArray<uint8> Truncated(Bytes.GetData(), Bytes.Num() / 2);
+    TestFalse(TEXT("Truncated bytes are rejected"), Plan->ReadBinary(NewObject<UInterverseSerializationTestObject>(), Truncated));
+
+    AddInfo(FString::Printf(TEXT("Binary %d bytes, text %d values"), Bytes.Num(), Values.Num()));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseSerializationPlanTimingTest, "Interverse.Serialization.PlanTiming",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseSerializationPlanTimingTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumTransfers = 2000;
+
+    UInterverseSerializationWideObject* Source = MakeWideSource();
+    UInterverseSerializationWideObject* WalkTarget = NewObject<UInterverseSerializationWideObject>();
+    UInterverseSerializationWideObject* PlanTarget = NewObject<UInterverseSerializationWideObject>();
+    const UClass* Class = Source->GetClass();
+    TestEqual(TEXT("Wide class plans only its SaveGame properties"), FInterverseSerializationPlan::Get(Class)->GetProperties().Num(), 48);
+
+    // Each transfer writes the source and reads into a target, as a send and a receive would
+    TMap<FString, FString> WalkValues;
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Transfer = 0; Transfer < NumTransfers; ++Transfer)
+    {
+        WalkValues.Reset();
+        WriteTextByWalk(Source, WalkValues);
+        ReadTextByWalk(WalkTarget, WalkValues);
+    }
+    const double WalkMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    // The plan is fetched per transfer too, so its cache lookup is part of the cost
+    TMap<FString, FString> PlanValues;
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Transfer = 0; Transfer < NumTransfers; ++Transfer)
+    {
+        PlanValues.Reset();
+        const TSharedRef<const FInterverseSerializationPlan> Plan = FInterverseSerializationPlan::Get(Class);
+        Plan->WriteText(Source, PlanValues);
+        Plan->ReadText(PlanTarget, PlanValues);
+    }
+    const double PlanMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    TArray<uint8> Bytes;
+    for (int32 Transfer = 0; Transfer < NumTransfers; ++Transfer)
+    {
+        Bytes.Reset();
+        const TSharedRef<const FInterverseSerializationPlan> Plan = FInterverseSerializationPlan::Get(Class);
+        Plan->WriteBinary(Source, Bytes);
+        Plan->ReadBinary(PlanTarget, Bytes);
+    }
+    const double BinaryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TestTrue(TEXT("Plan writes the same values as the walk"), PlanValues.OrderIndependentCompareEqual(WalkValues));
+
+    TMap<FString, FString> WalkResult;
+    TMap<FString, FString> PlanResult;
+    WriteTextByWalk(WalkTarget, WalkResult);
+    WriteTextByWalk(PlanTarget, PlanResult);
+    TestTrue(TEXT("Both targets end up with the source's values"), PlanResult.OrderIndependentCompareEqual(WalkValues) && WalkResult.OrderIndependentCompareEqual(WalkValues));
+
+    AddInfo(FString::Printf(TEXT("%d transfers of %d properties: per-call walk %.2f ms, cached plan text %.2f ms, cached plan binary %.2f ms"),
+        NumTransfers, WalkValues.Num(), WalkMs, PlanMs, BinaryMs));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
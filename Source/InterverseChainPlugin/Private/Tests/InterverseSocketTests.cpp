@@ -0,0 +1,158 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseConnectionManager.h"
+#include "IWebSocket.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Stand-in node socket: connects at once and records every text frame written to it
+    class FFakeWebSocket : public IWebSocket
+    {
+    public:
+        TArray<FString> SentFrames;
+
+        virtual void Connect() override
+        {
+            bConnected = true;
+            ConnectedEvent.Broadcast();
+        }
+
+        virtual void Close(int32 Code = 1000, const FString& Reason = FString()) override
+        {
+            bConnected = false;
+        }
+
+        virtual bool IsConnected() override { return bConnected; }
+        virtual void Send(const FString& Data) override { SentFrames.Add(Data); }
+        virtual void Send(const void* Data, SIZE_T Size, bool bIsBinary = false) override {}
+        virtual void SetTextMessageMemoryLimit(uint64 TextMessageMemoryLimit) override {}
+
+        virtual FWebSocketConnectedEvent& OnConnected() override { return ConnectedEvent; }
+        virtual FWebSocketConnectionErrorEvent& OnConnectionError() override { return ConnectionErrorEvent; }
+        virtual FWebSocketClosedEvent& OnClosed() override { return ClosedEvent; }
+        virtual FWebSocketMessageEvent& OnMessage() override { return MessageEvent; }
+        virtual FWebSocketBinaryMessageEvent& OnBinaryMessage() override { return BinaryMessageEvent; }
+        virtual FWebSocketRawMessageEvent& OnRawMessage() override { return RawMessageEvent; }
+        virtual FWebSocketMessageSentEvent& OnMessageSent() override { return MessageSentEvent; }
+
+    private:
+        bool bConnected = false;
+        FWebSocketConnectedEvent ConnectedEvent;
+        FWebSocketConnectionErrorEvent ConnectionErrorEvent;
+        FWebSocketClosedEvent ClosedEvent;
+        FWebSocketMessageEvent MessageEvent;
+        FWebSocketBinaryMessageEvent BinaryMessageEvent;
+        FWebSocketRawMessageEvent RawMessageEvent;
+        FWebSocketMessageSentEvent MessageSentEvent;
+    };
+
+    TSet<FString> ReadStringSet(const FJsonObject& Json, const TCHAR* Field)
+    {
+        TSet<FString> Values;
+        const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+        if (Json.TryGetArrayField(Field, Array))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *Array)
+            {
+                Values.Add(Value->AsString());
+            }
+        }
+        return Values;
+    }
+
+    // Whether the frames written since Start are exactly one topic message with these topics
+    bool SentOneTopicMessage(const FFakeWebSocket& Socket, int32 Start, const TCHAR* Type, const TSet<FString>& Addresses, const TSet<FString>& AssetIds)
+    {
+        if (Socket.SentFrames.Num() != Start + 1)
+        {
+            return false;
+        }
+
+        TSharedPtr<FJsonObject> Json;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Socket.SentFrames[Start]);
+        if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+        {
+            return false;
+        }
+
+        return Json->GetStringField(TEXT("type")) == Type &&
+            ReadStringSet(*Json, TEXT("addresses")).Includes(Addresses) && Addresses.Includes(ReadStringSet(*Json, TEXT("addresses"))) &&
+            ReadStringSet(*Json, TEXT("asset_ids")).Includes(AssetIds) && AssetIds.Includes(ReadStringSet(*Json, TEXT("asset_ids")));
+    }
+
+    FInterverseSocketSubscriber MakeSubscriber(const TSet<FString>& Addresses, const TSet<FString>& AssetIds)
+    {
+        FInterverseSocketSubscriber Subscriber;
+        Subscriber.Owner = GetTransientPackage();
+        Subscriber.Addresses = Addresses;
+        Subscriber.AssetIds = AssetIds;
+        return Subscriber;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseSocketTopicMirrorTest, "Interverse.Socket.TopicMirror",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseSocketTopicMirrorTest::RunTest(const FString& Parameters)
+{
+    TSharedRef<FInterverseSocketConnection> Connection = MakeShared<FInterverseSocketConnection>(
+        TEXT("http://localhost"), TEXT("test-key"), TEXT("InterverseTestGame"), 1.0f, 30.0f, FInterverseSendQueueSettings(), EInterverseWireFormat::Json);
+
+    TSharedPtr<FFakeWebSocket> Socket;
+    Connection->SetSocketFactory([&Socket](const FString&, const FString&, const TMap<FString, FString>&) -> TSharedPtr<IWebSocket>
+    {
+        Socket = MakeShared<FFakeWebSocket>();
+        return Socket;
+    });
+
+    // Nothing goes out before the session exists
+    const int32 Wallet = Connection->AddSubscriber(MakeSubscriber({ TEXT("0xA") }, {}));
+    const int32 Item = Connection->AddSubscriber(MakeSubscriber({}, { TEXT("Sword") }));
+    Connection->Connect();
+    if (!TestTrue(TEXT("Fake socket connects"), Socket.IsValid() && Connection->IsConnected()))
+    {
+        return false;
+    }
+
+    // The handshake is followed by the union of every subscriber's topics
+    TestTrue(TEXT("Session opens with the handshake"), Socket->SentFrames.Num() == 2 && Socket->SentFrames[0].Contains(TEXT("\"handshake\"")));
+    TestTrue(TEXT("Session subscribes to the union"), SentOneTopicMessage(*Socket, 1, TEXT("subscribe"), { TEXT("0xA") }, { TEXT("Sword") }));
+
+    // Only the difference goes over the wire
+    int32 Start = Socket->SentFrames.Num();
+    Connection->AddSubscriberAddress(Wallet, TEXT("0xB"));
+    TestTrue(TEXT("New address is subscribed on its own"), SentOneTopicMessage(*Socket, Start, TEXT("subscribe"), { TEXT("0xB") }, {}));
+
+    Start = Socket->SentFrames.Num();
+    Connection->AddSubscriberAddress(Item, TEXT("0xA"));
+    Connection->RemoveSubscriberAddress(Wallet, TEXT("0xA"));
+    TestEqual(TEXT("Topic still wanted by another subscriber stays subscribed"), Socket->SentFrames.Num(), Start);
+
+    Start = Socket->SentFrames.Num();
+    Connection->RemoveSubscriber(Item);
+    TestTrue(TEXT("Leaving subscriber's topics are dropped"), SentOneTopicMessage(*Socket, Start, TEXT("unsubscribe"), { TEXT("0xA") }, { TEXT("Sword") }));
+
+    // An unfiltered subscriber needs the whole feed, which the node sends when no topics are set
+    Start = Socket->SentFrames.Num();
+    const int32 Everything = Connection->AddSubscriber(MakeSubscriber({}, {}));
+    TestTrue(TEXT("Unfiltered subscriber clears the topics"), SentOneTopicMessage(*Socket, Start, TEXT("unsubscribe"), { TEXT("0xB") }, {}));
+
+    Start = Socket->SentFrames.Num();
+    Connection->RemoveSubscriber(Everything);
+    TestTrue(TEXT("Filters return once it leaves"), SentOneTopicMessage(*Socket, Start, TEXT("subscribe"), { TEXT("0xB") }, {}));
+
+    // A new session starts with no topics on the node side, so they are sent in full again
+    const TSharedPtr<FFakeWebSocket> OldSocket = Socket;
+    Connection->Reconnect();
+    TestTrue(TEXT("Reconnect opens a new socket"), Socket.IsValid() && Socket != OldSocket);
+    TestTrue(TEXT("New session resubscribes after its handshake"), Socket->SentFrames.Num() == 2 && SentOneTopicMessage(*Socket, 1, TEXT("subscribe"), { TEXT("0xB") }, {}));
+
+    Connection->Close();
+    TestFalse(TEXT("Closed"), Connection->IsConnected());
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
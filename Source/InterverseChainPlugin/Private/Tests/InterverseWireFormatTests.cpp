@@ -0,0 +1,100 @@
+#include "Misc/AutomationTest.h"
+#include "InterverseWireFormat.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Covers every marker family the encoder emits: fixint, 8-64 bit ints, negatives, doubles,
+    // short and long strings, nested containers, booleans and null
+    TSharedRef<FJsonObject> MakeTestMessage()
+    {
+        TSharedRef<FJsonObject> Asset = MakeShared<FJsonObject>();
+        Asset->SetStringField(TEXT("asset_id"), TEXT("Sword_42"));
+        Asset->SetStringField(TEXT("name"), TEXT("\u00C9p\u00E9e \"longue\" \u4E16"));
+        Asset->SetNumberField(TEXT("level"), 7);
+        Asset->SetNumberField(TEXT("damage"), 12.75);
+        Asset->SetBoolField(TEXT("equipped"), true);
+        Asset->SetBoolField(TEXT("bound"), false);
+        Asset->SetField(TEXT("owner_global_id"), MakeShared<FJsonValueNull>());
+
+        TArray<TSharedPtr<FJsonValue>> Numbers;
+        for (double Number : { 0.0, 127.0, 128.0, 255.0, 65535.0, 65536.0, 4294967296.0, -1.0, -32.0, -33.0, -129.0, -32769.0, -2147483649.0, 0.1, -1.5e10 })
+        {
+            Numbers.Add(MakeShared<FJsonValueNumber>(Number));
+        }
+        Asset->SetArrayField(TEXT("numbers"), Numbers);
+
+        TArray<TSharedPtr<FJsonValue>> Tags;
+        for (int32 Index = 0; Index < 20; ++Index)
+        {
+            Tags.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("Tag_%d"), Index)));
+        }
+        Asset->SetArrayField(TEXT("tags"), Tags);
+
+        TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+        Message->SetStringField(TEXT("type"), TEXT("asset_update"));
+        Message->SetNumberField(TEXT("seq"), 123456789);
+        Message->SetStringField(TEXT("description"), FString::ChrN(300, TEXT('x')));
+        Message->SetObjectField(TEXT("asset"), Asset);
+        return Message;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterverseWireMessagePackTest, "Interverse.Wire.MessagePack",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInterverseWireMessagePackTest::RunTest(const FString& Parameters)
+{
+    const TSharedRef<FJsonObject> Message = MakeTestMessage();
+
+    TArray<uint8> Packed;
+    InterverseWire::ToMessagePack(Message, Packed);
+    TestTrue(TEXT("Encodes to bytes"), Packed.Num() > 0);
+
+    const TSharedPtr<FJsonObject> Decoded = InterverseWire::FromMessagePack(Packed);
+    if (!TestTrue(TEXT("Decodes back to an object"), Decoded.IsValid()))
+    {
+        return false;
+    }
+
+    TestEqual(TEXT("Round trip keeps every value"), InterverseWire::ToJsonString(Decoded.ToSharedRef()), InterverseWire::ToJsonString(Message));
+
+    const TSharedPtr<FJsonObject>* Asset = nullptr;
+    TestTrue(TEXT("Nested object survives"), Decoded->TryGetObjectField(TEXT("asset"), Asset) && Asset);
+    if (Asset)
+    {
+        TestEqual(TEXT("Non-ASCII string"), (*Asset)->GetStringField(TEXT("name")), Message->GetObjectField(TEXT("asset"))->GetStringField(TEXT("name")));
+        TestTrue(TEXT("Null stays null"), (*Asset)->HasTypedField<EJson::Null>(TEXT("owner_global_id")));
+        TestEqual(TEXT("Fractional number"), (*Asset)->GetNumberField(TEXT("damage")), 12.75);
+    }
+
+    // Anything short of one whole map is rejected rather than half-decoded
+    TArray<uint8> Truncated(Packed.GetData(), Packed.Num() - 1);
+    TestFalse(TEXT("Truncated bytes are rejected"), InterverseWire::FromMessagePack(Truncated).IsValid());
+
+    TArray<uint8> NotAMap;
+    InterverseWire::ToMessagePack(MakeShared<FJsonValueString>(TEXT("hello")), NotAMap);
+    TestFalse(TEXT("A bare string is rejected"), InterverseWire::FromMessagePack(NotAMap).IsValid());
+
+    // Spliced envelopes decode the same as ones encoded from a tree
+    TArray<uint8> Envelope;
+    InterverseWire::AppendMapHeader(Envelope, 2);
+    InterverseWire::AppendString(Envelope, TEXT("type"));
+    InterverseWire::AppendString(Envelope, TEXT("batch"));
+    InterverseWire::AppendString(Envelope, TEXT("messages"));
+    InterverseWire::AppendArrayHeader(Envelope, 2);
+    Envelope.Append(Packed);
+    Envelope.Append(Packed);
+
+    const TSharedPtr<FJsonObject> Batch = InterverseWire::FromMessagePack(Envelope);
+    const TArray<TSharedPtr<FJsonValue>>* Messages = nullptr;
+    TestTrue(TEXT("Spliced envelope decodes"), Batch.IsValid() && Batch->TryGetArrayField(TEXT("messages"), Messages) && Messages && Messages->Num() == 2);
+
+    const FInterverseWireComparison Comparison = InterverseWire::Compare(Message, 100);
+    TestTrue(TEXT("Compare round-trips"), Comparison.bRoundTripped);
+    AddInfo(FString::Printf(TEXT("JSON %d bytes, MessagePack %d bytes"), Comparison.JsonBytes, Comparison.MessagePackBytes));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "InterverseInventoryComponent.h"
+#include "InterverseAssetCacheSave.generated.h"
+
+// On-disk copy of one wallet's inventory, so a session can show it before the node answers
+UCLASS()
+class INTERVERSECHAINPLUGIN_API UInterverseAssetCacheSave : public USaveGame
+{
+    GENERATED_BODY()
+
+public:
+    // Bump when the layout of FInterverseInventoryItem or FInterverseAsset, or the content hash, changes
+    static constexpr int32 CurrentVersion = 2;
+
+    UPROPERTY()
+    int32 Version = 0;
+
+    UPROPERTY()
+    FString WalletAddress;
+
+    // SHA-1 of the cached assets as hex; equal hashes mean the node has nothing new for us
+    UPROPERTY()
+    FString ContentHash;
+
+    UPROPERTY()
+    FDateTime SavedAt;
+
+    UPROPERTY()
+    TArray<FInterverseInventoryItem> Items;
+};
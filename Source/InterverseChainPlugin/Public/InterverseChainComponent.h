@@ -9,12 +9,97 @@
 #include "Async/AsyncWork.h"
 #include "InterverseStandardTypes.h"
 #include "InterverseChainDelegates.h"
+#include "InterverseHttpDispatcher.h"
+#include "InterverseConnectionManager.h"
+#include "InterverseLedgerMirror.h"
+#include "InterverseCompactTypes.h"
 #include "InterverseChainComponent.generated.h"
 
 // Declare WebSocket delegates
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWebSocketConnected, bool, Success);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWebSocketMessage, const FString&, Message);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPlayerAssetsReceived, const FString&, PlayerAddress, const TArray<FInterverseAsset>&, Assets);
+
+USTRUCT(BlueprintType)
+struct FInterverseTransactionPage
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|History")
+    TArray<FString> Transactions;
+
+    // Pass back to GetTransactionHistoryPage for the following page; empty on the last page
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|History")
+    FString NextCursor;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|History")
+    bool bHasMore = false;
+
+    // Highest ledger sequence the node has for this wallet; use as SinceSequence to fetch only newer entries
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|History")
+    int64 LatestSequence = -1;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLedgerSynced, int64, Height, int32, NewBlocks);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnTransactionPageReceived, bool, bSuccess, const FInterverseTransactionPage&, Page);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTransactionHistorySynced, const FString&, Address, const TArray<FString>&, NewTransactions);
+
+// Per-record completion for batched transaction submission
+typedef TFunction<void(bool bSuccess, const FString& Result)> FOnTransactionRecorded;
+
+// Per-caller completion for coalesced queries
+typedef TFunction<void(bool bSuccess, float Balance)> FOnBalanceQueried;
+typedef TFunction<void(bool bSuccess, const TArray<FInterverseAsset>& Assets)> FOnPlayerAssetsQueried;
+typedef TFunction<void(bool bSuccess, const FInterverseTransactionPage& Page)> FOnTransactionPageQueried;
+
+// Incremental delivery of large lists; chunks arrive on the game thread in order, then completion
+typedef TFunction<void(const TArray<FInterverseAsset>& Chunk)> FOnAssetChunk;
+typedef TFunction<void(const TArray<FString>& Chunk)> FOnTransactionChunk;
+typedef TFunction<void(bool bSuccess)> FOnListStreamComplete;
+
+// Game-thread handler for one decoded message type
+typedef TFunction<void(const FInterverseDecodedPayload& Payload)> FInterverseMessageHandler;
+
+USTRUCT(BlueprintType)
+struct FInterverseTransactionBatchStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 PendingRecords = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 BatchesFlushed = 0;
+
+    // Batches the node has answered, successfully or not; the latency average runs over these
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 BatchesCompleted = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 RecordsFlushed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 LastBatchSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 LargestBatchSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    float LastFlushLatencyMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    float AverageFlushLatencyMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Chain")
+    int32 FailedBatches = 0;
+
+    float GetAverageBatchSize() const
+    {
+        return BatchesFlushed > 0 ? static_cast<float>(RecordsFlushed) / BatchesFlushed : 0.0f;
+    }
+};
+
 UCLASS(ClassGroup=(Blockchain), meta=(BlueprintSpawnableComponent))
 class INTERVERSECHAINPLUGIN_API UInterverseChainComponent : public UActorComponent
 {
@@ -29,12 +114,72 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interverse|Chain")
     void RecordTransaction(const FString& TransactionData);
 
+    // Queues a record for batched submission; OnComplete fires once the node answers for this record
+    void RecordTransaction(const FString& TransactionData, FOnTransactionRecorded OnComplete);
+
+    // Same, from a JSON tree; sent as MessagePack when the node accepts it over HTTP
+    void RecordTransaction(const TSharedRef<FJsonObject>& Record, FOnTransactionRecorded OnComplete = FOnTransactionRecorded());
+
+    // Sends every queued record now instead of waiting for a batch threshold
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Chain")
+    void FlushTransactionBatch();
+
+    UFUNCTION(BlueprintPure, Category = "Interverse|Chain")
+    FInterverseTransactionBatchStats GetTransactionBatchStats() const { return BatchStats; }
+
+    // Serializes the local ledger mirror and starts an incremental sync.
+    // Prefer the GetLedger* queries, which don't build the whole chain as a string.
     UFUNCTION(BlueprintCallable, Category = "Interverse|Chain")
     void GetLedgerState(FString& OutLedgerState);
 
+    // Downloads only the blocks after the mirror's tip and verifies they chain by hash
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Ledger")
+    void SyncLedger();
+
+    UFUNCTION(BlueprintPure, Category = "Interverse|Ledger")
+    int64 GetLedgerHeight() const;
+
+    UFUNCTION(BlueprintPure, Category = "Interverse|Ledger")
+    FString GetLedgerLatestHash() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Ledger")
+    bool GetLedgerBlock(int64 Index, FInterverseLedgerBlock& OutBlock) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Ledger")
+    void GetLedgerBlocksSince(int64 Index, int32 MaxBlocks, TArray<FInterverseLedgerBlock>& OutBlocks) const;
+
+    // Reads the mirror cached on disk for this node; a sync requested meanwhile waits for it
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Ledger")
+    void LoadLedgerMirror();
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Ledger")
+    void SaveLedgerMirror();
+
+    UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
+    FOnLedgerSynced OnLedgerSynced;
+
+    // Fills OutTransactions from the locally synced history and starts an incremental sync;
+    // listen to OnTransactionHistorySynced for entries that arrive afterwards
     UFUNCTION(BlueprintCallable, Category = "Interverse|Chain")
     void GetTransactionHistory(const FString& Address, TArray<FString>& OutTransactions);
 
+    // One page of a wallet's history. Pass an empty Cursor for the first page and a negative
+    // SinceSequence for the full history. The following page is prefetched while this one is consumed.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|History")
+    void GetTransactionHistoryPage(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence, const FOnTransactionPageReceived& OnPage);
+
+    void GetTransactionHistoryPage(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence, FOnTransactionPageQueried OnPage);
+
+    // Pages in everything newer than the last sync and appends it to the local history
+    UFUNCTION(BlueprintCallable, Category = "Interverse|History")
+    void SyncTransactionHistory(const FString& Address);
+
+    UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
+    FOnTransactionHistorySynced OnTransactionHistorySynced;
+
+    // Like StreamPlayerAssets, for the wallet's transaction list
+    void StreamTransactionHistory(const FString& Address, int32 ChunkSize, FOnTransactionChunk OnChunk, FOnListStreamComplete OnComplete);
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Configuration")
     FString NodeUrl;
 
@@ -44,9 +189,65 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Configuration")
     FString ApiKey;
 
+    // First reconnect delay; later attempts back off exponentially with jitter
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Configuration")
     float ReconnectDelay = 5.0f;
 
+    // Ceiling for the reconnect backoff
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Configuration")
+    float MaxReconnectDelay = 60.0f;
+
+    // Outbound WebSocket queue limits, overflow policy and frame coalescing
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network")
+    FInterverseSendQueueSettings SendQueueSettings;
+
+    // Offered to the node in the handshake. JSON stays in use until the node accepts, and
+    // chain request bodies switch to the same format once it has.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network")
+    EInterverseWireFormat PreferredWireFormat = EInterverseWireFormat::Json;
+
+    // Upper bound on chain HTTP requests in flight to this node, shared with every other
+    // component using the same node; the rest wait in priority order
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network", meta=(ClampMin="1"))
+    int32 MaxConcurrentRequests = 8;
+
+    // Collect RecordTransaction calls and submit them together
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Batching")
+    bool bBatchTransactions = true;
+
+    // Flush once this many records are queued
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Batching", meta=(ClampMin="1"))
+    int32 MaxBatchRecords = 64;
+
+    // Flush once the queued payload reaches this many bytes
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Batching", meta=(ClampMin="1"))
+    int32 MaxBatchBytes = 64 * 1024;
+
+    // Flush at most this many seconds after the first record was queued
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Batching", meta=(ClampMin="0.0"))
+    float BatchFlushInterval = 0.25f;
+
+    // Seconds a balance or asset list stays valid before GetBalance/GetPlayerAssets hit the node again
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Caching", meta=(ClampMin="0.0"))
+    float ResponseCacheTTL = 2.0f;
+
+    // Hold cached asset lists in interned compact form. Saves the per-asset metadata key copies
+    // for wallets with many assets, at the cost of expanding the list on each cache hit.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Caching")
+    bool bCompactAssetCache = false;
+
+    // Keep the ledger mirror in Saved/Interverse between sessions
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Ledger")
+    bool bPersistLedgerMirror = true;
+
+    // Page size used by SyncTransactionHistory
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|History", meta=(ClampMin="1"))
+    int32 HistoryPageSize = 100;
+
+    // Request the next history page in the background as soon as one arrives
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|History")
+    bool bPrefetchHistoryPages = true;
+
     UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
     FOnAssetMinted OnAssetMinted;
 
@@ -56,6 +257,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
     FOnBalanceUpdated OnBalanceUpdated;
 
+    UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
+    FOnPlayerAssetsReceived OnPlayerAssetsReceived;
+
     UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
     FOnWebSocketConnected OnWebSocketConnected;
 
@@ -68,6 +272,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interverse|Wallet")
     void GetBalance(const FString& Address);
 
+    // Concurrent calls for the same address share one request; cached results are returned immediately
+    void GetBalance(const FString& Address, FOnBalanceQueried OnComplete);
+
     UFUNCTION(BlueprintCallable, Category = "Interverse|Assets")
     void MintGameAsset(const FString& OwnerAddress, 
                       const FInterverseBaseProperties& Properties,
@@ -78,33 +285,198 @@ public:
                       const FString& FromAddress, 
                       const FString& ToAddress);
 
+    // Delivers and caches the wallet's full asset list in one array, so the whole list is held in
+    // memory at once; use StreamPlayerAssets for very large wallets
     UFUNCTION(BlueprintCallable, Category = "Interverse|Assets")
     void GetPlayerAssets(const FString& PlayerAddress);
 
+    void GetPlayerAssets(const FString& PlayerAddress, FOnPlayerAssetsQueried OnComplete);
+
+    // Parses the asset list incrementally and hands it over in chunks without ever holding the
+    // whole list; bypasses the response cache. Use for wallets with very large inventories.
+    void StreamPlayerAssets(const FString& PlayerAddress, int32 ChunkSize, FOnAssetChunk OnChunk, FOnListStreamComplete OnComplete);
+
+    // Drops cached balance and asset responses so the next query goes to the node
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Caching")
+    void InvalidateResponseCache(const FString& Address);
+
     UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
     void ConnectWebSocket();
 
     UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
     void DisconnectWebSocket();
 
+    // Queued while disconnected and sent in order once the socket is back
     UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
     void SendWebSocketMessage(const FString& Message);
 
+    // Encoded in the socket's negotiated format
+    void SendWebSocketMessage(const TSharedRef<FJsonObject>& Message);
+
+    // Format the node agreed to for this session; JSON until it answers the handshake
+    UFUNCTION(BlueprintPure, Category = "Interverse|Network")
+    EInterverseWireFormat GetWireFormat() const;
+
     UFUNCTION(BlueprintPure, Category = "Interverse|Network")
     bool IsWebSocketConnected() const;
 
     UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
     void ReconnectWebSocket();
 
+    // Narrow this component's share of the node socket to specific wallets or assets.
+    // The node is told too, so unrelated traffic never reaches this client.
+    // With no subscriptions the component receives every message, as before.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
+    void SubscribeToAddress(const FString& Address);
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
+    void UnsubscribeFromAddress(const FString& Address);
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
+    void SubscribeToAsset(const FString& AssetId);
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Network")
+    void UnsubscribeFromAsset(const FString& AssetId);
+
+    // Open shared sockets, subscriber count and routed message rate across all components
+    UFUNCTION(BlueprintPure, Category = "Interverse|Network")
+    FInterverseSocketStats GetSocketStats() const;
+
     UFUNCTION(BlueprintPure, Category = "Interverse|Network")
     FString GetConnectionStatus() const;
 
+    // Handle a message type on this component, replacing any existing handler for it.
+    // Custom types arrive with their JSON unless a decoder is registered in FInterverseMessageRegistry.
+    void RegisterMessageHandler(FName Type, FInterverseMessageHandler Handler);
+    void UnregisterMessageHandler(FName Type);
+
+    // Runs the handler for a payload from FInterverseConnectionManager::DecodeMessage; game thread only
+    void ApplyDecodedPayload(const FInterverseDecodedPayload& Payload);
+
+    // Queue depth per priority lane, in-flight count and request latency, for all traffic to this node
+    UFUNCTION(BlueprintPure, Category = "Interverse|Network")
+    FInterverseHttpStats GetHttpStats() const;
+
 private:
-    FHttpModule* Http;
-    TSharedPtr<IWebSocket> WebSocket;
-    FTimerHandle ReconnectTimerHandle;
+    TSharedPtr<FInterverseHttpDispatcher> HttpDispatcher;
+
+    TSharedPtr<FInterverseLedgerMirror> LedgerMirror;
+    bool bLedgerLoading = false;
+    bool bLedgerSyncing = false;
+    bool bLedgerSyncPending = false;
+
+    void RequestLedgerBlocks(bool bFullDownload);
+    void OnLedgerBlocksDecoded(bool bFullDownload, bool bParsed, TArray<FInterverseLedgerBlock>&& Blocks);
+    FString GetLedgerMirrorPath() const;
+
+    // Shared node socket and this component's subscription on it
+    TSharedPtr<FInterverseSocketConnection> SocketConnection;
+    int32 SocketSubscriberHandle = INDEX_NONE;
+
+    // Kept here so subscriptions made before connecting, or across reconnects, still apply
+    TSet<FString> SubscribedAddresses;
+    TSet<FString> SubscribedAssetIds;
+
+    // Data holds JSON or plain text; records queued as MessagePack keep their tree for a JSON fallback
+    struct FPendingTransaction
+    {
+        FString Data;
+
+        // Data parsed as a JSON value when queued, so batches can splice it in unchanged
+        bool bDataIsJson = false;
+
+        TArray<uint8> Packed;
+        TSharedPtr<FJsonObject> Object;
+        FOnTransactionRecorded OnComplete;
+    };
+
+    TArray<FPendingTransaction> PendingTransactions;
+    int32 PendingTransactionBytes = 0;
+    FTimerHandle BatchFlushTimerHandle;
+    FInterverseTransactionBatchStats BatchStats;
+
+    // Generation is the cache's push generation when the entry was written
+    struct FCachedBalance
+    {
+        float Balance = 0.0f;
+        double Timestamp = 0.0;
+        uint64 Generation = 0;
+    };
+
+    // One of Assets or CompactAssets holds the list, depending on bCompact
+    struct FCachedAssets
+    {
+        TArray<FInterverseAsset> Assets;
+        TArray<FInterverseCompactAsset> CompactAssets;
+        bool bCompact = false;
+        double Timestamp = 0.0;
+        uint64 Generation = 0;
+
+        void Store(const TArray<FInterverseAsset>& InAssets, bool bInCompact);
+        void Expand(TArray<FInterverseAsset>& OutAssets) const;
+        int32 IndexOf(const FString& AssetId) const;
+        void Put(int32 Index, const FInterverseAsset& Asset);
+        void RemoveAt(int32 Index);
+    };
+
+    // Bumped by every push or local write that changes the cache; GET responses issued
+    // under an older generation may predate the change and are not cached
+    uint64 BalancePushGeneration = 0;
+    uint64 AssetPushGeneration = 0;
+
+    // Response caches and in-flight waiters, keyed by address per endpoint
+    TMap<FString, FCachedBalance> BalanceCache;
+    TMap<FString, FCachedAssets> AssetCache;
+    TMap<FString, TArray<FOnBalanceQueried>> InFlightBalanceQueries;
+    TMap<FString, TArray<FOnPlayerAssetsQueried>> InFlightAssetQueries;
+
+    // History pages keyed by address, cursor, page size and since-sequence
+    TMap<FString, TArray<FOnTransactionPageQueried>> InFlightHistoryPages;
+    TMap<FString, FInterverseTransactionPage> PrefetchedHistoryPages;
+
+    // Keys of PrefetchedHistoryPages, oldest first
+    TArray<FString> PrefetchedHistoryOrder;
+
+    struct FTransactionHistoryMirror
+    {
+        TArray<FString> Transactions;
+        int64 LatestSequence = -1;
+        bool bSyncing = false;
+    };
+
+    TMap<FString, FTransactionHistoryMirror> HistoryMirrors;
+
+    void RequestHistoryPage(const FString& Address, const FString& Cursor, int32 PageSize, int64 SinceSequence, FOnTransactionPageQueried OnPage);
+    void CompleteHistoryPage(const FString& Key, const FString& Address, int32 PageSize, int64 SinceSequence, bool bParsed, const FInterverseTransactionPage& Page);
+    void PrefetchHistoryPage(const FString& Address, const FInterverseTransactionPage& Page, int32 PageSize, int64 SinceSequence);
+    void SyncHistoryStep(const FString& Address, const FString& Cursor, int64 SinceSequence, TSharedRef<TArray<FString>> NewTransactions);
+
+    bool IsCacheEntryFresh(double Timestamp) const;
+    void OnBalanceResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess, FString Address, uint64 IssuedGeneration);
+    void OnPlayerAssetsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess, FString Address, uint64 IssuedGeneration);
+    void CompleteBalanceQuery(const FString& Address, bool bParsed, float Balance, uint64 IssuedGeneration);
+    void CompletePlayerAssetsQuery(const FString& Address, bool bParsed, const TArray<FInterverseAsset>& Assets, uint64 IssuedGeneration);
+    void UpdateCachedBalance(const FString& Address, float Balance);
+    void UpdateCachedAsset(const FInterverseAsset& Asset);
+    void InvalidateCachedAsset(const FString& AssetId);
+
+    void QueuePendingTransaction(FPendingTransaction&& Pending, int32 Bytes);
+    void SendTransactionBatch(TArray<FPendingTransaction>&& Batch);
+    void OnTransactionBatchResponse(FHttpResponsePtr Response, bool bSuccess, TArray<FPendingTransaction> Batch, double SendTime);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateChainRequest(const FString& Verb, const FString& Path);
+    void SubmitChainRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, EInterverseRequestPriority Priority);
+    void SetRequestBody(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const TSharedRef<FJsonObject>& Body) const;
+
+    // Format for HTTP request bodies; JSON unless the node advertised MessagePack for HTTP
+    EInterverseWireFormat GetHttpWireFormat() const;
+
+    // Decodes one endpoint's response on a worker; must not touch UObjects
+    typedef bool (*FHttpPayloadDecoder)(const FJsonObject& Root, FInterverseDecodedPayload& Out);
+
+    // Keyed by interned message type; built-in types are registered in the constructor
+    TMap<FName, FInterverseMessageHandler> MessageHandlers;
+    void RegisterBuiltInMessageHandlers();
 
-    void OnHttpResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess);
-    void ProcessWebSocketMessage(const FString& Message);
-    void ScheduleReconnect();
+    void OnHttpResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess, FHttpPayloadDecoder Decoder);
 };
\ No newline at end of file
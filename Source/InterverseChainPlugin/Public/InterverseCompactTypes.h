@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InterverseStandardTypes.h"
+#include "InterverseChainDelegates.h"
+
+// Process-wide table mapping property keys ("Damage", "DamageType", ...) to small integer symbols.
+// Keys are matched case-sensitively so a compact bag converts back to exactly the strings it was built from.
+class INTERVERSECHAINPLUGIN_API FInterversePropertyKeyTable
+{
+public:
+    static FInterversePropertyKeyTable& Get();
+
+    // Returns the symbol for Key, adding it on first use
+    int32 Intern(const FString& Key);
+
+    // Returns INDEX_NONE for keys that were never interned
+    int32 Find(const FString& Key) const;
+
+    const FString& Resolve(int32 Symbol) const;
+
+    int32 Num() const;
+
+private:
+    struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+    {
+        static FORCEINLINE const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+        static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static FORCEINLINE uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+    };
+
+    mutable FRWLock Lock;
+    TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> SymbolsByKey;
+
+    // Strings are heap-allocated once and never freed, so references from Resolve stay valid
+    TArray<TUniquePtr<FString>> KeysBySymbol;
+};
+
+// Flat, interned form of FInterverseBaseProperties for large in-memory collections
+struct INTERVERSECHAINPLUGIN_API FInterverseCompactProperties
+{
+    EInterverseItemCategory Category = EInterverseItemCategory::Weapon;
+    EInterverseRarity Rarity = EInterverseRarity::Common;
+    int32 Level = 0;
+    FString ModelIdentifier;
+    FLinearColor PrimaryColor = FLinearColor(ForceInit);
+    FLinearColor SecondaryColor = FLinearColor(ForceInit);
+
+    // Entries keep the insertion order of the source maps
+    TArray<TPair<int32, float>> NumericProperties;
+    TArray<TPair<int32, FString>> StringProperties;
+
+    TArray<FString> Tags;
+    FString OwnerGlobalID;
+    FString TargetPlayerID;
+
+    static FInterverseCompactProperties FromProperties(const FInterverseBaseProperties& Properties);
+    FInterverseBaseProperties ToProperties() const;
+
+    const float* FindNumeric(int32 Symbol) const;
+    const float* FindNumeric(const FString& Key) const;
+    const FString* FindString(int32 Symbol) const;
+    const FString* FindString(const FString& Key) const;
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+// Flat, interned form of FInterverseAsset
+struct INTERVERSECHAINPLUGIN_API FInterverseCompactAsset
+{
+    FString AssetId;
+    FString Owner;
+    FString OwnerGlobalID;
+    EInterverseAssetType AssetType = EInterverseAssetType::COSMETIC;
+    EInterverseItemCategory Category = EInterverseItemCategory::Weapon;
+    EInterverseRarity Rarity = EInterverseRarity::Common;
+    TArray<TPair<int32, FString>> Metadata;
+
+    static FInterverseCompactAsset FromAsset(const FInterverseAsset& Asset);
+    FInterverseAsset ToAsset() const;
+
+    const FString* FindMetadata(int32 Symbol) const;
+    const FString* FindMetadata(const FString& Key) const;
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+namespace InterverseCompact
+{
+    // Heap bytes owned by the Blueprint structs, for comparing against the compact forms
+    INTERVERSECHAINPLUGIN_API SIZE_T GetAllocatedSize(const FInterverseBaseProperties& Properties);
+    INTERVERSECHAINPLUGIN_API SIZE_T GetAllocatedSize(const FInterverseAsset& Asset);
+}
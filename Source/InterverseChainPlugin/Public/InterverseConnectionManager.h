@@ -0,0 +1,343 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IWebSocket.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "InterverseChainDelegates.h"
+#include "InterverseWireFormat.h"
+#include "InterverseConnectionManager.generated.h"
+
+// Typed result of decoding a node payload off the game thread
+struct FInterverseDecodedPayload
+{
+    // Interned message type; NAME_None when the frame named a type nothing registered
+    FName Type;
+    FString RawMessage;
+    bool bValid = false;
+
+    // Parsed frame, kept only for types that have no registered decoder
+    TSharedPtr<FJsonObject> Json;
+
+    FInterverseAsset Asset;
+    FString AssetId;
+    FString Address;
+    float Balance = 0.0f;
+    bool bSuccess = false;
+
+    // Node-assigned sequence number, or -1 when the node did not stamp the message
+    int64 ServerSequence = -1;
+};
+
+UENUM(BlueprintType)
+enum class EInterverseSendOverflowPolicy : uint8
+{
+    DropOldest  UMETA(DisplayName = "Drop Oldest"),  // Make room by discarding the oldest queued message
+    Reject      UMETA(DisplayName = "Reject"),       // Refuse the new message
+    Block       UMETA(DisplayName = "Block")         // Drain the queue to the socket before accepting more
+};
+
+// Limits for the outbound queue of a shared socket; the first component to open the socket sets them,
+// and later components with different values get a warning
+USTRUCT(BlueprintType)
+struct FInterverseSendQueueSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network", meta=(ClampMin="1"))
+    int32 MaxQueuedMessages = 1024;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network", meta=(ClampMin="1"))
+    int32 MaxQueuedBytes = 256 * 1024;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network")
+    EInterverseSendOverflowPolicy OverflowPolicy = EInterverseSendOverflowPolicy::DropOldest;
+
+    // Pack consecutive messages queued in the same frame into one "batch" envelope, once the node
+    // lists "batch" in the capabilities of its handshake_ack; until then every message goes out alone
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network")
+    bool bCoalesceFrames = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network", meta=(ClampMin="1"))
+    int32 MaxCoalescedFrameBytes = 16 * 1024;
+
+    // Sustained send rate; zero sends as fast as the queue fills
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Network", meta=(ClampMin="0"))
+    int32 MaxBytesPerSecond = 64 * 1024;
+};
+
+USTRUCT(BlueprintType)
+struct FInterverseSocketStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OpenSockets = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 Subscribers = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 MessagesReceived = 0;
+
+    // Deliveries to subscribers; one message routed to three components counts three times
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 MessagesRouted = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    float MessagesRoutedPerSecond = 0.0f;
+
+    // Deliveries skipped because the subscriber's address/asset filter did not match
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 MessagesFiltered = 0;
+
+    // Sessions re-established after an unexpected drop
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 Reconnects = 0;
+
+    // Seconds from the drop to the handshake of the most recent recovery
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    float LastRecoverySeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    float LongestRecoverySeconds = 0.0f;
+
+    // Messages waiting in outbound queues right now
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundQueued = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundQueuedBytes = 0;
+
+    // Deepest any outbound queue has been
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundHighWaterMessages = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundHighWaterBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundMessagesSent = 0;
+
+    // Socket frames written; lower than messages sent when coalescing kicks in
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundFramesSent = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundDropped = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 OutboundRejected = 0;
+};
+
+// One party interested in a shared socket's traffic
+struct FInterverseSocketSubscriber
+{
+    // Deliveries stop once the owner is gone
+    TWeakObjectPtr<UObject> Owner;
+
+    TFunction<void(bool bConnected)> OnConnected;
+    TFunction<void(const FInterverseDecodedPayload& Payload)> OnMessage;
+
+    // Empty sets receive everything; otherwise only messages about these wallets or assets
+    TSet<FString> Addresses;
+    TSet<FString> AssetIds;
+};
+
+// A WebSocket to one node shared by every component using the same NodeUrl, ApiKey and GameId.
+// Frames are decoded once on a worker and routed to matching subscribers on the game thread.
+// The union of subscriber filters is mirrored to the node with subscribe/unsubscribe messages
+// so it only sends traffic someone on this socket wants.
+class INTERVERSECHAINPLUGIN_API FInterverseSocketConnection : public TSharedFromThis<FInterverseSocketConnection>
+{
+public:
+    FInterverseSocketConnection(const FString& InNodeUrl, const FString& InApiKey, const FString& InGameId, float InReconnectDelay, float InMaxReconnectDelay, const FInterverseSendQueueSettings& InSendSettings, EInterverseWireFormat InPreferredFormat);
+    ~FInterverseSocketConnection();
+
+    int32 AddSubscriber(FInterverseSocketSubscriber&& Subscriber);
+    void RemoveSubscriber(int32 Handle);
+    int32 NumSubscribers() const { return Subscribers.Num(); }
+
+    void AddSubscriberAddress(int32 Handle, const FString& Address);
+    void RemoveSubscriberAddress(int32 Handle, const FString& Address);
+    void AddSubscriberAsset(int32 Handle, const FString& AssetId);
+    void RemoveSubscriberAsset(int32 Handle, const FString& AssetId);
+
+    // Creates the socket for each session; the WebSockets module unless replaced before Connect
+    typedef TFunction<TSharedPtr<IWebSocket>(const FString& Url, const FString& Protocol, const TMap<FString, FString>& Headers)> FSocketFactory;
+    void SetSocketFactory(FSocketFactory InFactory) { SocketFactory = MoveTemp(InFactory); }
+
+    void Connect();
+    void Close();
+    void Reconnect();
+
+    bool IsConnected() const;
+    bool IsCreated() const { return WebSocket.IsValid(); }
+
+    // Queues the message for the socket; held across disconnects and flushed in order.
+    // Returns false when the overflow policy refused it.
+    bool Send(const FString& Message);
+
+    // Queues a message in the format negotiated for this session: a binary frame once the node
+    // has agreed to MessagePack, JSON text otherwise
+    bool Send(const TSharedRef<FJsonObject>& Message);
+
+    // JSON until the node acknowledges the preferred format in reply to the handshake
+    EInterverseWireFormat GetNegotiatedFormat() const { return NegotiatedFormat; }
+
+    // Format for HTTP request bodies to this node. The socket format says nothing about the REST
+    // endpoints, so MessagePack needs its own "http_msgpack" capability in the handshake_ack.
+    EInterverseWireFormat GetHttpFormat() const
+    {
+        return bNodeAcceptsHttpMessagePack && PreferredFormat == EInterverseWireFormat::MessagePack ? EInterverseWireFormat::MessagePack : EInterverseWireFormat::Json;
+    }
+
+    // Whether a caller asking for these settings gets what it asked for; they are fixed when the socket is created
+    bool HasSettings(float InReconnectDelay, float InMaxReconnectDelay, const FInterverseSendQueueSettings& InSendSettings, EInterverseWireFormat InPreferredFormat) const;
+
+    // Adds this socket's outbound queue figures to Stats
+    void AccumulateStats(FInterverseSocketStats& Stats) const;
+
+private:
+    FString NodeUrl;
+    FString ApiKey;
+    FString GameId;
+    float ReconnectDelay;
+    float MaxReconnectDelay;
+
+    TSharedPtr<IWebSocket> WebSocket;
+    FSocketFactory SocketFactory;
+    bool bClosing = false;
+
+    // Offered in the handshake; every session starts in JSON until the node picks a format
+    EInterverseWireFormat PreferredFormat;
+    EInterverseWireFormat NegotiatedFormat = EInterverseWireFormat::Json;
+
+    // Set from the handshake_ack capabilities; cleared for every new session
+    bool bNodeAcceptsBatches = false;
+    bool bNodeAcceptsHttpMessagePack = false;
+
+    // Fragments of the binary frame being received
+    TArray<uint8> PendingBinaryFrame;
+
+    // Reconnect backoff; DisconnectedAt is zero while the session is healthy
+    FTSTicker::FDelegateHandle ReconnectTickerHandle;
+    int32 ReconnectAttempts = 0;
+    double DisconnectedAt = 0.0;
+
+    // Either JSON text, or MessagePack bytes plus the tree they came from so they can still go
+    // out as text if the next session falls back to JSON
+    struct FOutboundMessage
+    {
+        FString Text;
+        TArray<uint8> Packed;
+        TSharedPtr<FJsonObject> Object;
+
+        // Text parsed as exactly one JSON object when it was queued, so it can go inside a batch envelope
+        bool bTextIsObject = false;
+
+        int32 GetSize() const { return Packed.Num() > 0 ? Packed.Num() : Text.Len(); }
+    };
+
+    // Outbound messages not yet written to the socket, oldest first
+    FInterverseSendQueueSettings SendSettings;
+    TArray<FOutboundMessage> OutboundQueue;
+    int32 OutboundQueuedBytes = 0;
+    double SendAllowanceBytes = 0.0;
+    FTSTicker::FDelegateHandle FlushTickerHandle;
+
+    int32 OutboundHighWaterMessages = 0;
+    int32 OutboundHighWaterBytes = 0;
+    int32 OutboundMessagesSent = 0;
+    int32 OutboundFramesSent = 0;
+    int32 OutboundDropped = 0;
+    int32 OutboundRejected = 0;
+
+    // Highest node sequence routed, sent in the handshake so the node can replay what we missed
+    int64 LastServerSequence = -1;
+
+    // Node's sequence epoch from the last handshake_ack; sequences only compare within one epoch
+    FString ServerEpoch;
+
+    // Topics the node has acknowledged for this socket session
+    TSet<FString> RemoteAddresses;
+    TSet<FString> RemoteAssetIds;
+
+    int32 NextSubscriberHandle = 0;
+    TMap<int32, FInterverseSocketSubscriber> Subscribers;
+
+    // Decoded messages are routed in arrival order
+    uint64 NextSequence = 0;
+    uint64 NextSequenceToRoute = 0;
+    TMap<uint64, TSharedPtr<FInterverseDecodedPayload>> DecodedMessages;
+
+    void BindSocketHandlers();
+    void QueueDecode(TFunction<void(FInterverseDecodedPayload& Payload)> Decode);
+    void ApplyHandshakeAck(const FInterverseDecodedPayload& Payload);
+    void RebaseServerSequence(const FInterverseDecodedPayload& Payload);
+    void SendNow(const TSharedRef<FJsonObject>& Message);
+    bool Enqueue(FOutboundMessage&& Message);
+    void OnMessageDecoded(uint64 Sequence, TSharedPtr<FInterverseDecodedPayload> Payload);
+    void RouteMessage(const FInterverseDecodedPayload& Payload);
+    void NotifyConnected(bool bConnected);
+    void OnSessionOpened();
+    void OnSessionLost();
+    void DestroySocket();
+    void SyncRemoteTopics();
+    void SendTopicMessage(const TCHAR* Type, const TSet<FString>& Addresses, const TSet<FString>& AssetIds);
+    void ScheduleReconnect();
+    void CancelReconnect();
+    float GetNextReconnectDelay() const;
+    bool MakeRoomFor(int32 MessageBytes);
+    void ScheduleFlush();
+    bool FlushOutbound(float DeltaTime);
+    void DrainOutbound(double ByteBudget);
+    void ClearOutbound();
+
+    static bool SubscriberWants(const FInterverseSocketSubscriber& Subscriber, const FInterverseDecodedPayload& Payload);
+};
+
+// Process-wide owner of shared node sockets, one per (NodeUrl, ApiKey, GameId)
+class INTERVERSECHAINPLUGIN_API FInterverseConnectionManager
+{
+public:
+    static FInterverseConnectionManager& Get();
+
+    // Returns the shared connection for this node and game, creating it on first use.
+    // Each game gets its own socket since the node scopes a session to the game_id in its handshake.
+    TSharedRef<FInterverseSocketConnection> Acquire(const FString& NodeUrl, const FString& ApiKey, const FString& GameId, float ReconnectDelay, float MaxReconnectDelay, const FInterverseSendQueueSettings& SendSettings, EInterverseWireFormat PreferredFormat);
+
+    // Closes and forgets the connection once its last subscriber is gone
+    void Release(const TSharedPtr<FInterverseSocketConnection>& Connection);
+
+    // Closes every socket; called on module shutdown
+    void Shutdown();
+
+    FInterverseSocketStats GetStats() const;
+
+    // Decodes a raw frame; safe to call from any thread
+    static void DecodeMessage(const FString& Message, FInterverseDecodedPayload& OutPayload);
+    static void DecodeBinaryMessage(TArrayView<const uint8> Message, FInterverseDecodedPayload& OutPayload);
+
+private:
+    friend class FInterverseSocketConnection;
+
+    TMap<FString, TSharedRef<FInterverseSocketConnection>> Connections;
+
+    int32 MessagesReceived = 0;
+    int32 MessagesRouted = 0;
+    double RateWindowStart = 0.0;
+    int32 RateWindowCount = 0;
+    float MessagesRoutedPerSecond = 0.0f;
+    int32 MessagesFiltered = 0;
+    int32 Reconnects = 0;
+    float LastRecoverySeconds = 0.0f;
+    float LongestRecoverySeconds = 0.0f;
+
+    void NoteMessageReceived();
+    void NoteReconnected(float RecoverySeconds);
+    void NoteMessagesRouted(int32 Count, int32 Filtered);
+
+    static FString MakeKey(const FString& NodeUrl, const FString& ApiKey, const FString& GameId);
+    static void DecodeObject(const TSharedPtr<FJsonObject>& JsonObject, FInterverseDecodedPayload& Out);
+};
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "InterverseStandardTypes.h"
+#include "Misc/Optional.h"
+#include "Async/Future.h"
 #include "InterverseConversionTypes.generated.h"
 
 USTRUCT(BlueprintType)
@@ -28,6 +30,46 @@ struct INTERVERSECHAINPLUGIN_API FInterverseConversionRule
     TMap<FString, FLinearColor> ColorMappings;
 };
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnAssetsBatchConverted, const TArray<FInterverseBaseProperties>&, ConvertedItems);
+
+// Key of the compiled rule index
+struct FInterverseConversionRuleKey
+{
+    FString FromGame;
+    FString ToGame;
+    EInterverseItemCategory Category;
+
+    FInterverseConversionRuleKey(const FString& InFromGame, const FString& InToGame, EInterverseItemCategory InCategory)
+        : FromGame(InFromGame), ToGame(InToGame), Category(InCategory)
+    {
+    }
+
+    bool operator==(const FInterverseConversionRuleKey& Other) const
+    {
+        return Category == Other.Category && FromGame == Other.FromGame && ToGame == Other.ToGame;
+    }
+
+    friend uint32 GetTypeHash(const FInterverseConversionRuleKey& Key)
+    {
+        return HashCombine(HashCombine(GetTypeHash(Key.FromGame), GetTypeHash(Key.ToGame)), GetTypeHash(Key.Category));
+    }
+};
+
+// Lookup plan built once per rule so a conversion is one pass over the item's properties
+struct FInterverseCompiledConversionRule
+{
+    int32 RuleIndex = INDEX_NONE;
+    TMap<FString, float> NumericConversionRates;
+    TMap<FString, FString> PropertyMappings;
+    TOptional<FLinearColor> PrimaryColor;
+    TOptional<FLinearColor> SecondaryColor;
+
+    static TSharedRef<const FInterverseCompiledConversionRule> Compile(const FInterverseConversionRule& Rule, int32 RuleIndex);
+
+    // Applies the rule in place; safe to call from any thread
+    void Apply(FInterverseBaseProperties& Properties) const;
+};
+
 UCLASS(Blueprintable, BlueprintType)
 class INTERVERSECHAINPLUGIN_API UInterverseConversionSubsystem : public UGameInstanceSubsystem
 {
@@ -49,6 +91,25 @@ public:
         const FString& ToGame
     );
 
+    // Converts many items in parallel on worker threads. When bInvokeBlueprintHook is set and
+    // OnAssetConverted is implemented, the hook runs on the game thread before the future completes.
+    // Must be called from the game thread.
+    TFuture<TArray<FInterverseBaseProperties>> ConvertAssetsBatch(
+        const TArray<FInterverseBaseProperties>& Items,
+        const FString& FromGame,
+        const FString& ToGame,
+        bool bInvokeBlueprintHook = true
+    );
+
+    // Blueprint form of ConvertAssetsBatch; OnComplete fires on the game thread
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Conversion")
+    void ConvertAssetsBatchAsync(
+        const TArray<FInterverseBaseProperties>& Items,
+        const FString& FromGame,
+        const FString& ToGame,
+        FOnAssetsBatchConverted OnComplete
+    );
+
     // Blueprint event that can be implemented to modify conversion results
     UFUNCTION(BlueprintImplementableEvent, Category = "Interverse|Conversion")
     void OnAssetConverted(
@@ -62,6 +123,19 @@ protected:
     UPROPERTY()
     TArray<FInterverseConversionRule> ConversionRules;
 
+    // Compiled rules keyed by (FromGame, ToGame, Category). Subclasses editing ConversionRules
+    // directly should call RebuildRuleIndex; a size change is picked up automatically.
+    TMap<FInterverseConversionRuleKey, TSharedRef<const FInterverseCompiledConversionRule>> CompiledRules;
+    int32 CompiledRuleCount = 0;
+
+    const FInterverseCompiledConversionRule* FindCompiledRule(
+        const FString& FromGame,
+        const FString& ToGame,
+        EInterverseItemCategory Category
+    );
+
+    void RebuildRuleIndex();
+
     // Helper function to find applicable conversion rule
     FInterverseConversionRule* FindConversionRule(
         const FString& FromGame,
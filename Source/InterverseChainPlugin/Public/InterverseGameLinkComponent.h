@@ -5,8 +5,14 @@
 #include "InterverseStandardTypes.h"
 #include "GameFramework/Actor.h"
 #include "Json.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
 #include "InterverseGameLinkComponent.generated.h"
 
+class UInterverseChainComponent;
+class UInterversePlayerComponent;
+struct FStreamableHandle;
+
 // Declare delegates first, before the component class
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameLinkEstablished, const FString&, TargetGameId);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAssetTransferredToPlayer, const FString&, AssetID, const FString&, TargetPlayerID);
@@ -15,6 +21,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnObjectTransferred, const FStri
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnObjectReceived, UObject*, ReceivedObject, const FString&, SourceId);
 
 
+UENUM(BlueprintType)
+enum class EInterverseTransferEncoding : uint8
+{
+    Binary  UMETA(DisplayName = "Binary"),  // SaveGame properties packed into PropertyData
+    Text    UMETA(DisplayName = "Text")     // One exported string per property in ObjectData; for debugging
+};
+
 USTRUCT(BlueprintType)
 struct FGameLinkConfig
 {
@@ -66,6 +79,13 @@ struct FTransferredObjectData
     UPROPERTY(BlueprintReadWrite, Category = "Game Link")
     TMap<FString, FString> ObjectData;
 
+    // Which of ObjectData or PropertyData carries the property values
+    UPROPERTY(BlueprintReadWrite, Category = "Game Link")
+    EInterverseTransferEncoding Encoding = EInterverseTransferEncoding::Text;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Game Link")
+    TArray<uint8> PropertyData;
+
     UPROPERTY(BlueprintReadWrite, Category = "Game Link")
     bool bIsValid;
 
@@ -75,6 +95,85 @@ struct FTransferredObjectData
     }
 };
 
+// Outcome of one actor in a TransferGameObjects call
+USTRUCT(BlueprintType)
+struct FGameLinkTransferResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    TWeakObjectPtr<AActor> Actor;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    FString ObjectId;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    bool bSuccess = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    FString Error;
+
+    // What the receiving game passes to SpawnReceivedObject
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    FTransferredObjectData Data;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnObjectsTransferred, const TArray<FGameLinkTransferResult>&, Results, bool, bAllSucceeded);
+
+USTRUCT(BlueprintType)
+struct FGameLinkTransferStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    EInterverseTransferEncoding LastEncoding = EInterverseTransferEncoding::Binary;
+
+    // Property payload of the last serialized object; for text, the characters of keys and values
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 LastPayloadBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    float LastSerializeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    float LastDeserializeMs = 0.0f;
+};
+
+// Frame cost of the receive queue, for keeping bulk receives within a frame budget
+USTRUCT(BlueprintType)
+struct FGameLinkReceiveStats
+{
+    GENERATED_BODY()
+
+    // Objects waiting to be spawned
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 PendingSpawns = 0;
+
+    // Objects held until their mapped class finishes streaming in; they join PendingSpawns then
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 WaitingForClass = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 LastFrameSpawns = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    float LastFrameSpawnMs = 0.0f;
+
+    // Longest single frame the queue has taken since the stats were reset
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    float PeakFrameSpawnMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 TotalSpawned = 0;
+
+    // How many of TotalSpawned came out of the actor pool
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 TotalReused = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Game Link")
+    int32 TotalFailed = 0;
+};
+
 UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class INTERVERSECHAINPLUGIN_API UInterverseGameLinkComponent : public UActorComponent
 {
@@ -96,9 +195,36 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
     bool TransferObjectData(const FTransferredObjectData& ObjectData, const FString& TargetGameId);
 
+    // Transfers a group of actors, such as a player's mount, pets and gear, as one operation.
+    // Binary payloads of plain-data classes are serialized in parallel and the group is recorded as a single on-chain
+    // transaction. OnObjectsTransferred fires once with a result per actor.
+    // Returns false if nothing could be submitted.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
+    bool TransferGameObjects(const TArray<AActor*>& Actors, const FString& TargetGameId, const FString& TargetPlayerID);
+
+    // Spawns the object now. Returns null if its mapped class is still streaming in; the object is
+    // then held and spawned through the receive queue once the class loads, firing OnObjectReceived.
     UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
     AActor* SpawnReceivedObject(const FTransferredObjectData& ObjectData);
 
+    // Queues received objects to be spawned over the following frames within SpawnBudgetMs each.
+    // Classes are resolved once per distinct class in the batch. Objects whose mapped class is still
+    // streaming in wait for it; objects whose class can't be resolved at all are dropped here.
+    // OnObjectReceived fires as each one spawns. Returns how many were queued or held.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
+    int32 QueueReceivedObjects(const TArray<FTransferredObjectData>& Objects);
+
+    // Hands a received actor back. With pooling enabled it is hidden and kept for the next object
+    // of its class, otherwise it is destroyed.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
+    void ReleaseReceivedObject(AActor* Actor);
+
+    UFUNCTION(BlueprintPure, Category = "Interverse|Game Link")
+    FGameLinkReceiveStats GetReceiveStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
+    void ResetReceiveStats();
+
     // Blueprint-accessible getters
     UFUNCTION(BlueprintPure, Category = "Interverse|Game Link")
     bool IsGameLinked(const FString& GameId) const;
@@ -109,6 +235,26 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interverse|Game Link")
     bool GetGameLinkConfig(const FString& GameId, FGameLinkConfig& OutConfig) const;
 
+    UFUNCTION(BlueprintPure, Category = "Interverse|Game Link")
+    FGameLinkTransferStats GetTransferStats() const { return TransferStats; }
+
+    // How SerializeActor packs properties; received objects are read in whichever encoding they carry
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Game Link")
+    EInterverseTransferEncoding TransferEncoding = EInterverseTransferEncoding::Binary;
+
+    // Milliseconds of spawning the receive queue may use per frame; at least one object spawns each frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Game Link", meta = (ClampMin = "0.1"))
+    float SpawnBudgetMs = 2.0f;
+
+    // Reuse actors handed back through ReleaseReceivedObject instead of spawning new ones.
+    // Reused actors only have their SaveGame properties overwritten, so any other state they
+    // picked up must be reset by the game.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Game Link")
+    bool bPoolReceivedActors = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interverse|Game Link", meta = (ClampMin = "0", EditCondition = "bPoolReceivedActors"))
+    int32 MaxPooledActorsPerClass = 8;
+
     // Blueprint events
     UPROPERTY(BlueprintAssignable, Category = "Interverse|Game Link")
     FOnGameLinkEstablished OnGameLinkEstablished;
@@ -125,14 +271,78 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
     FOnObjectReceived OnObjectReceived;
 
+    UPROPERTY(BlueprintAssignable, Category = "Interverse|Events")
+    FOnObjectsTransferred OnObjectsTransferred;
+
 protected:
     // Store game link configurations
     UPROPERTY()
     TMap<FString, FGameLinkConfig> GameLinks;
 
+    FGameLinkTransferStats TransferStats;
+
+    // Sibling components, found once instead of on every transfer
+    TWeakObjectPtr<UInterverseChainComponent> CachedChainComponent;
+    TWeakObjectPtr<UInterversePlayerComponent> CachedPlayerComponent;
+
+    UInterverseChainComponent* GetChainComponent();
+    UInterversePlayerComponent* GetPlayerComponent();
+
+    struct FPendingSpawn
+    {
+        FTransferredObjectData Data;
+        TWeakObjectPtr<UClass> TargetClass;
+    };
+
+    // Consumed from PendingSpawnHead so draining doesn't shift the array every spawn
+    TArray<FPendingSpawn> PendingSpawns;
+    int32 PendingSpawnHead = 0;
+
+    FTSTicker::FDelegateHandle SpawnTickerHandle;
+    FGameLinkReceiveStats ReceiveStats;
+
+    // Released actors by class, hidden until reused
+    TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>> ActorPool;
+
+    // A link's ClassMappings resolved for hashed lookup. Classes holds the pairs whose classes are
+    // both loaded; Paths holds every pair by source path, for sources reinstanced since resolving
+    // and targets still streaming in.
+    struct FResolvedClassMappings
+    {
+        TMap<TObjectKey<UClass>, TWeakObjectPtr<UClass>> Classes;
+        TMap<FSoftObjectPath, TSoftClassPtr<UObject>> Paths;
+
+        // Keeps the preloaded target classes resident while the link is registered
+        TSharedPtr<FStreamableHandle> LoadHandle;
+
+        // Received objects whose target class was still loading; queued again when LoadHandle completes
+        TArray<FTransferredObjectData> WaitingObjects;
+    };
+
+    TMap<FString, FResolvedClassMappings> ResolvedClassMappings;
+
+    void ResolveClassMappings(const FString& GameId);
+    void RebuildResolvedClasses(const FString& GameId);
+    void OnClassMappingsLoaded(const FString& GameId);
+    void WaitForMappedClass(const FTransferredObjectData& ObjectData);
+    void ReleaseClassMappings();
+
+    bool TickSpawnQueue(float DeltaTime);
+    void ClearSpawnQueue();
+    void ClearActorPool();
+
+    UClass* ResolveReceivedClass(const FTransferredObjectData& ObjectData, bool* bOutStillLoading = nullptr) const;
+    AActor* SpawnResolvedObject(const FTransferredObjectData& ObjectData, UClass* TargetClass);
+    AActor* AcquirePooledActor(UClass* TargetClass);
+
     // Helper functions
     bool SerializeActor(AActor* Actor, FTransferredObjectData& OutData);
+
+    // Touches nothing but the actor's SaveGame properties; may run on worker threads in binary mode
+    // when the class's plan IsPlainData
+    static bool SerializeActorData(AActor* Actor, EInterverseTransferEncoding Encoding, FTransferredObjectData& OutData, int32& OutPayloadBytes);
     bool DeserializeToActor(const FTransferredObjectData& Data, AActor* OutActor);
     void RecordTransferOnChain(const FString& SourceGameId, const FString& TargetGameId, const FString& ObjectId, const FString& SourcePlayerID, const FString& TargetPlayerID);
-    UClass* FindMappedClass(UClass* SourceClass, const FString& TargetGameId) const;
+    // Null when unmapped to anything loadable; bOutStillLoading tells apart a target that is still streaming in
+    UClass* FindMappedClass(UClass* SourceClass, const FString& TargetGameId, bool* bOutStillLoading = nullptr) const;
 };
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Http.h"
+#include "Containers/Queue.h"
+#include "InterverseHttpDispatcher.generated.h"
+
+UENUM(BlueprintType)
+enum class EInterverseRequestPriority : uint8
+{
+    High        UMETA(DisplayName = "High"),     // Player-facing queries
+    Normal      UMETA(DisplayName = "Normal"),   // Wallet and asset operations
+    Low         UMETA(DisplayName = "Low")       // Background ledger writes and syncs
+};
+
+USTRUCT(BlueprintType)
+struct FInterverseHttpStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 InFlight = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 QueuedHigh = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 QueuedNormal = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 QueuedLow = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 PeakQueueDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 Completed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    int32 Failed = 0;
+
+    // Time spent waiting for a concurrency slot
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    float AverageQueueWaitMs = 0.0f;
+
+    // Time from ProcessRequest to completion
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    float AverageLatencyMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Network")
+    float LastLatencyMs = 0.0f;
+};
+
+// Sends chain requests through a bounded concurrency window with priority lanes.
+// One dispatcher exists per node and API key, shared by every component talking to that node,
+// so the concurrency limit bounds the process's traffic to it.
+// The URL prefix and shared headers are built once per configuration rather than per request.
+// Not thread-safe: create, submit and complete requests on the game thread.
+class INTERVERSECHAINPLUGIN_API FInterverseHttpDispatcher : public TSharedFromThis<FInterverseHttpDispatcher>
+{
+public:
+    FInterverseHttpDispatcher();
+
+    // The shared dispatcher for a node; lives as long as some caller holds it
+    static TSharedRef<FInterverseHttpDispatcher> Acquire(const FString& NodeUrl, const FString& ApiKey);
+
+    bool IsConfiguredFor(const FString& NodeUrl, const FString& ApiKey) const;
+
+    // Cheap when nothing changed, so callers can invoke it before every request.
+    // The limit is shared, so the most recently configured value applies to every caller.
+    void Configure(const FString& NodeUrl, const FString& ApiKey, int32 MaxConcurrentRequests);
+
+    // Path is relative to the node URL, e.g. "verse/wallet/create" or "chain"
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FString& Verb, const FString& Path) const;
+
+    // Queues the request; it starts once a slot is free and no higher-priority request is waiting.
+    // The request's own completion delegate still fires as usual. Owner identifies the caller
+    // for ReleaseOwner.
+    void Submit(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, EInterverseRequestPriority Priority, const UObject* Owner = nullptr);
+
+    // For a caller going away: its queued writes start at once so they are not lost, and its
+    // queued reads fail through their completion delegates. In-flight requests are left alone.
+    void ReleaseOwner(const UObject* Owner);
+
+    const FInterverseHttpStats& GetStats() const { return Stats; }
+
+private:
+    struct FQueuedRequest
+    {
+        TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
+        double EnqueueTime = 0.0;
+        const UObject* Owner = nullptr;
+    };
+
+    static constexpr int32 NumLanes = 3;
+
+    FString ConfiguredNodeUrl;
+    FString ConfiguredApiKey;
+    FString UrlPrefix;
+    TArray<TPair<FString, FString>> CommonHeaders;
+    int32 MaxInFlight = 8;
+
+    TQueue<FQueuedRequest> Lanes[NumLanes];
+    int32 LaneDepth[NumLanes] = {};
+    TSet<TSharedPtr<IHttpRequest, ESPMode::ThreadSafe>> ActiveRequests;
+
+    FInterverseHttpStats Stats;
+    double TotalQueueWaitMs = 0.0;
+    double TotalLatencyMs = 0.0;
+    int32 StartedCount = 0;
+
+    int32 GetQueueDepth() const;
+    void PumpQueue();
+    void StartRequest(FQueuedRequest&& Queued);
+    void OnRequestFinished(TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request, bool bSucceeded, double StartTime);
+    void UpdateQueueStats();
+
+    static void FailQueued(const FQueuedRequest& Queued);
+};
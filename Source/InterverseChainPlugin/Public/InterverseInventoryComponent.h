@@ -23,7 +23,62 @@ struct FInterverseInventoryItem
     int32 Slot;
 };
 
+UENUM(BlueprintType)
+enum class EInterverseInventoryChangeKind : uint8
+{
+    Added       UMETA(DisplayName = "Added"),
+    Removed     UMETA(DisplayName = "Removed"),
+    Changed     UMETA(DisplayName = "Changed")
+};
+
+USTRUCT(BlueprintType)
+struct FInterverseInventoryChange
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse")
+    EInterverseInventoryChangeKind Kind = EInterverseInventoryChangeKind::Changed;
+
+    // State after the change; for removals, the item as it was removed
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse")
+    FInterverseInventoryItem Item;
+};
+
+USTRUCT(BlueprintType)
+struct FInterverseInventoryCacheStats
+{
+    GENERATED_BODY()
+
+    // From LoadCachedInventory to the cached items being in the inventory
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    float LoadMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    int32 BytesRead = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    int32 BytesWritten = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    int32 ItemsLoaded = 0;
+
+    // Outcome of the last reconcile against the node
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    bool bCacheWasCurrent = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    int32 ReconcileAdded = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    int32 ReconcileRemoved = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Inventory")
+    int32 ReconcileChanged = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryCacheLoaded, bool, bFromCache);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryUpdated, const TArray<FInterverseInventoryItem>&, Items);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChanged, const TArray<FInterverseInventoryChange>&, Changes);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class INTERVERSECHAINPLUGIN_API UInterverseInventoryComponent : public UActorComponent
@@ -51,12 +106,27 @@ public:
                                   const FString& FromPlayerID, 
                                   const FString& ToPlayerID);
 
+    // Full item list after each notification; prefer OnInventoryChanged for large inventories
     UPROPERTY(BlueprintAssignable, Category = "Interverse|Inventory")
     FOnInventoryUpdated OnInventoryUpdated;
 
+    // Only the items that were added, removed or changed since the last notification
+    UPROPERTY(BlueprintAssignable, Category = "Interverse|Inventory")
+    FOnInventoryChanged OnInventoryChanged;
+
+    // Mutations between Begin and End are merged into a single notification
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void BeginInventoryBatch();
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void EndInventoryBatch();
+
+    // Items are keyed by AssetId: returns false if an item with the same AssetId, including
+    // an empty one, is already in the inventory
     UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
     bool AddItem(const FInterverseAsset& Asset);
 
+    // The remaining items keep their order; Slot keeps the value assigned when the item was added
     UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
     bool RemoveItem(const FString& AssetId);
 
@@ -71,4 +141,120 @@ public:
 
     UFUNCTION(BlueprintPure, Category = "Interverse|Inventory")
     int32 GetInventorySize() const;
+
+    // Fill a caller-owned array, reusing its buffer and the string and map storage of the
+    // elements already in it between calls
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void FillPlayerItems(const FString& PlayerGlobalID, UPARAM(ref) TArray<FInterverseInventoryItem>& OutItems) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void FillItemsByCategory(EInterverseItemCategory Category, UPARAM(ref) TArray<FInterverseInventoryItem>& OutItems) const;
+
+    // Copy-free views into Items. Spans and pointers stay valid only until the next mutation.
+    TConstArrayView<int32> GetPlayerItemIndices(const FString& PlayerGlobalID) const;
+    TConstArrayView<int32> GetCategoryItemIndices(EInterverseItemCategory Category) const;
+    const FInterverseInventoryItem* FindItem(const FString& AssetId) const;
+    void GetPlayerItemPointers(const FString& PlayerGlobalID, TArray<const FInterverseInventoryItem*>& OutItems) const;
+
+    template<typename FunctorType>
+    void ForEachPlayerItem(const FString& PlayerGlobalID, FunctorType&& Functor) const
+    {
+        for (int32 Index : GetPlayerItemIndices(PlayerGlobalID))
+        {
+            Functor(Items[Index]);
+        }
+    }
+
+    template<typename FunctorType>
+    void ForEachItemInCategory(EInterverseItemCategory Category, FunctorType&& Functor) const
+    {
+        for (int32 Index : GetCategoryItemIndices(Category))
+        {
+            Functor(Items[Index]);
+        }
+    }
+
+    // Fills the inventory from the wallet's on-disk cache without waiting for the node.
+    // The file is read on a worker; OnInventoryCacheLoaded fires once the items are in.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void LoadCachedInventory(const FString& WalletAddress);
+
+    // Writes the wallet's items (those whose asset Owner is WalletAddress) to its cache slot
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void SaveInventoryCache(const FString& WalletAddress);
+
+    // Fetches the wallet's assets from the node and applies only the differences,
+    // then refreshes the cache. Skips all work when the content hash is unchanged.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void ReconcileWithChain(UInterverseChainComponent* ChainComponent, const FString& WalletAddress);
+
+    // Second half of ReconcileWithChain: applies the wallet's asset list once the node has answered
+    void ApplyChainAssets(const FString& WalletAddress, const TArray<FInterverseAsset>& Assets);
+
+    UFUNCTION(BlueprintPure, Category = "Interverse|Inventory")
+    FInterverseInventoryCacheStats GetCacheStats() const { return CacheStats; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Interverse|Inventory")
+    FOnInventoryCacheLoaded OnInventoryCacheLoaded;
+
+    // Call after editing Items directly so the lookup indices match again. Lookups also notice
+    // most direct edits themselves, but an edit that only renames an AssetId needs this call.
+    UFUNCTION(BlueprintCallable, Category = "Interverse|Inventory")
+    void RebuildIndices();
+
+private:
+    // Lookup indices into Items; rebuilt lazily if Items was changed from outside.
+    // Owner and category lists are kept sorted so queries return items in Items order.
+    mutable TMap<FString, int32> AssetIndex;
+    mutable TMap<FString, TArray<int32>> OwnerIndex;
+    mutable TMap<EInterverseItemCategory, TArray<int32>> CategoryIndex;
+    mutable int32 IndexedItemCount = 0;
+
+    int32 BatchDepth = 0;
+    TMap<FString, FInterverseInventoryChange> PendingChanges;
+    TArray<FString> PendingChangeOrder;
+
+    // Content hash of each wallet's assets as last loaded from or written to its cache
+    TMap<FString, FString> CachedContentHashes;
+    FInterverseInventoryCacheStats CacheStats;
+
+    void ApplyCachedBytes(const FString& WalletAddress, const TArray<uint8>& Bytes, double StartTime);
+
+    void RecordChange(EInterverseInventoryChangeKind Kind, const FInterverseInventoryItem& Item);
+    void FlushChanges();
+
+    bool AddItemInternal(const FInterverseAsset& Asset, const FString& PlayerGlobalID);
+    bool AddItemInternal(FInterverseInventoryItem&& NewItem);
+    void UpdateItemAsset(int32 Index, const FInterverseAsset& Asset);
+    int32 FindItemIndex(const FString& AssetId) const;
+    void IndexItem(int32 Index) const;
+    void UnindexItem(int32 Index) const;
+    void EnsureIndices() const;
+    void CopyItems(TConstArrayView<int32> Indices, TArray<FInterverseInventoryItem>& OutItems) const;
+    bool IsIndexListCurrent(const TArray<int32>& Indices, TFunctionRef<bool(const FInterverseInventoryItem&)> Matches) const;
+    void RebuildIndicesInternal() const;
+};
+
+// Merges every inventory mutation made while in scope into one notification
+struct FInterverseInventoryBatchScope
+{
+    explicit FInterverseInventoryBatchScope(UInterverseInventoryComponent* InInventory)
+        : Inventory(InInventory)
+    {
+        if (Inventory)
+        {
+            Inventory->BeginInventoryBatch();
+        }
+    }
+
+    ~FInterverseInventoryBatchScope()
+    {
+        if (Inventory)
+        {
+            Inventory->EndInventoryBatch();
+        }
+    }
+
+private:
+    UInterverseInventoryComponent* Inventory;
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "InterverseChainDelegates.h"
+
+// Pulls the items of a large JSON list out one at a time instead of deserializing the whole
+// response into a DOM. Only the item being read is materialised, so transient memory stays
+// flat however long the list is. Safe to use from worker threads.
+class INTERVERSECHAINPLUGIN_API FInterverseJsonListReader
+{
+public:
+    // Assets under "data" or "data.assets", delivered in chunks of up to ChunkSize
+    static bool ReadAssets(const FString& Content, int32 ChunkSize, TFunctionRef<void(TArray<FInterverseAsset>&& Chunk)> OnChunk);
+
+    // String entries of the top-level "transactions" list, delivered in chunks of up to ChunkSize
+    static bool ReadTransactions(const FString& Content, int32 ChunkSize, TFunctionRef<void(TArray<FString>&& Chunk)> OnChunk);
+
+    // Calls OnItem for each element of the first array found under one of the dotted paths.
+    // Returns false if the document is malformed or none of the paths holds an array.
+    static bool ForEachItem(const FString& Content, TArrayView<const TCHAR* const> ListPaths, TFunctionRef<void(const TSharedPtr<FJsonValue>& Item)> OnItem);
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InterverseLedgerMirror.generated.h"
+
+USTRUCT(BlueprintType)
+struct FInterverseLedgerBlock
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Ledger")
+    int64 Index = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Ledger")
+    FString Hash;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Ledger")
+    FString PreviousHash;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Ledger")
+    double Timestamp = 0.0;
+
+    // Each transaction as the node sent it, in condensed JSON
+    UPROPERTY(BlueprintReadOnly, Category = "Interverse|Ledger")
+    TArray<FString> Transactions;
+};
+
+FArchive& operator<<(FArchive& Ar, FInterverseLedgerBlock& Block);
+
+// Local copy of the node's chain. Blocks are appended only when they link to the current tip
+// by hash, so the mirror is always a contiguous prefix of what the node has.
+// Not thread-safe: build one on a worker, then hand it to the game thread.
+class INTERVERSECHAINPLUGIN_API FInterverseLedgerMirror
+{
+public:
+    // Index of the newest block, or -1 while the mirror is empty
+    int64 GetHeight() const { return Blocks.Num() > 0 ? Blocks.Last().Index : -1; }
+    FString GetLatestHash() const { return Blocks.Num() > 0 ? Blocks.Last().Hash : FString(); }
+    int32 Num() const { return Blocks.Num(); }
+
+    const FInterverseLedgerBlock* FindBlock(int64 Index) const;
+    void GetBlocksSince(int64 Index, int32 MaxBlocks, TArray<FInterverseLedgerBlock>& OutBlocks) const;
+
+    // Appends blocks that extend the tip and replaces any the node has rewritten.
+    // Returns the number of blocks taken, or INDEX_NONE when the blocks do not link up with
+    // the mirror and it has to be rebuilt from a full download.
+    int32 ApplyBlocks(TArray<FInterverseLedgerBlock>&& NewBlocks);
+
+    void Reset() { Blocks.Reset(); }
+
+    // The whole mirror in the node's /chain layout
+    FString ToJsonString() const;
+
+    // Versioned binary form for the on-disk cache; loading rejects data whose hashes do not chain
+    void SaveToBytes(TArray<uint8>& OutBytes) const;
+    bool LoadFromBytes(const TArray<uint8>& Bytes);
+
+    // Reads the blocks of a /chain response; safe to call from any thread
+    static bool DecodeBlocks(const FString& Content, TArray<FInterverseLedgerBlock>& OutBlocks);
+
+private:
+    TArray<FInterverseLedgerBlock> Blocks;
+
+    static bool Links(const FInterverseLedgerBlock& Previous, const FInterverseLedgerBlock& Next);
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeRWLock.h"
+
+struct FInterverseDecodedPayload;
+
+// Fills a payload from a parsed frame. Runs on worker threads, so it must not touch UObjects.
+typedef TFunction<bool(const FJsonObject& Json, FInterverseDecodedPayload& Out)> FInterverseMessageDecoder;
+
+// Interned names of the message types the node sends
+namespace InterverseMessageTypes
+{
+    INTERVERSECHAINPLUGIN_API extern const FName AssetUpdate;
+    INTERVERSECHAINPLUGIN_API extern const FName AssetMinted;
+    INTERVERSECHAINPLUGIN_API extern const FName BalanceUpdate;
+    INTERVERSECHAINPLUGIN_API extern const FName TransferComplete;
+    INTERVERSECHAINPLUGIN_API extern const FName HandshakeAck;
+}
+
+// Process-wide table of WebSocket message decoders keyed by the interned "type" field.
+// The built-in node messages are registered up front; game code can add its own types
+// and then handle them per component with UInterverseChainComponent::RegisterMessageHandler.
+class INTERVERSECHAINPLUGIN_API FInterverseMessageRegistry
+{
+public:
+    static FInterverseMessageRegistry& Get();
+
+    // Replaces any decoder already registered for Type
+    void RegisterDecoder(FName Type, FInterverseMessageDecoder Decoder);
+    void UnregisterDecoder(FName Type);
+
+    // Looks the type string up without adding it to the name table, so unknown
+    // types arriving from the network resolve to NAME_None instead of growing it
+    static FName FindType(const FString& TypeString);
+
+    // Types without a decoder still decode successfully and keep their JSON for handlers.
+    // Safe to call from any thread.
+    bool Decode(FName Type, const TSharedPtr<FJsonObject>& Json, FInterverseDecodedPayload& Out) const;
+
+private:
+    FInterverseMessageRegistry();
+
+    mutable FRWLock Lock;
+    TMap<FName, FInterverseMessageDecoder> Decoders;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/SoftObjectPath.h"
+
+// One SaveGame property of a class, resolved once
+struct FInterverseSerializedProperty
+{
+    FProperty* Property = nullptr;
+    int32 Offset = 0;
+    FName Name;
+
+    // Name as stored in transfer payloads, kept to avoid rebuilding the string per transfer
+    FString Key;
+
+    // Hash of the C++ type including container and element types; binary values are only read
+    // into a property of the same type
+    uint32 TypeHash = 0;
+
+    void* GetValuePtr(UObject* Object) const { return reinterpret_cast<uint8*>(Object) + Offset; }
+    const void* GetValuePtr(const UObject* Object) const { return reinterpret_cast<const uint8*>(Object) + Offset; }
+};
+
+// The SaveGame properties of a class in field order, with a name index for the reverse direction.
+// Built on first use per class and shared until hot reload or Blueprint reinstancing replaces classes.
+// Plans are immutable once built, so they can be shared across threads; see IsPlainData for which
+// ones can also serialize there.
+class INTERVERSECHAINPLUGIN_API FInterverseSerializationPlan
+{
+public:
+    static TSharedRef<const FInterverseSerializationPlan> Get(const UClass* Class);
+
+    // Drops every cached plan; the next Get rebuilds from the current class layout
+    static void InvalidateAll();
+
+    // Hooked up by the module so reloads flush the cache
+    static void RegisterInvalidationHooks();
+    static void UnregisterInvalidationHooks();
+
+    const TArray<FInterverseSerializedProperty>& GetProperties() const { return Properties; }
+    const FInterverseSerializedProperty* FindProperty(const FString& Key) const;
+
+    // True when every property is numeric, bool, enum, string or name, or a container or plain struct
+    // of those. Only such plans may be written with WriteBinary from worker threads.
+    bool IsPlainData() const { return bPlainData; }
+
+    // One exported string per property, keyed by name. Readable, but slow and bulky for arrays,
+    // structs and floats, so it is meant for debugging.
+    void WriteText(UObject* Object, TMap<FString, FString>& OutValues) const;
+    void ReadText(UObject* Object, const TMap<FString, FString>& Values) const;
+
+    // All properties packed into one buffer as name-tagged, length-prefixed binary values.
+    // Reading skips values the target class lacks or holds with a different type. Object references
+    // are only resolved to objects already in memory; the others are left null and their paths
+    // added to OutUnresolved, so the caller can stream them in and read again.
+    void WriteBinary(UObject* Object, TArray<uint8>& OutBytes) const;
+    bool ReadBinary(UObject* Object, const TArray<uint8>& Bytes, TArray<FSoftObjectPath>* OutUnresolved = nullptr) const;
+
+private:
+    explicit FInterverseSerializationPlan(const UClass* Class);
+
+    TArray<FInterverseSerializedProperty> Properties;
+    TMap<FName, int32> IndexByName;
+    bool bPlainData = true;
+};
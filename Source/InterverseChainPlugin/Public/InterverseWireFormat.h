@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "InterverseWireFormat.generated.h"
+
+UENUM(BlueprintType)
+enum class EInterverseWireFormat : uint8
+{
+    Json         UMETA(DisplayName = "JSON"),          // UTF-8 JSON text; every node understands it
+    MessagePack  UMETA(DisplayName = "MessagePack")    // Binary frames, used only once the node agrees in the handshake
+};
+
+// Size and speed of one payload in each encoding, from InterverseWire::Compare
+struct FInterverseWireComparison
+{
+    int32 JsonBytes = 0;
+    int32 MessagePackBytes = 0;
+
+    // Average microseconds per encode or decode
+    double JsonEncodeUs = 0.0;
+    double JsonDecodeUs = 0.0;
+    double MessagePackEncodeUs = 0.0;
+    double MessagePackDecodeUs = 0.0;
+
+    // The MessagePack bytes decoded back to a tree that re-encodes to the same JSON
+    bool bRoundTripped = false;
+};
+
+// Encodes the JSON object trees the plugin already builds either as JSON text or as MessagePack.
+// MessagePack carries the same value model, so handlers and decoders see identical trees either way.
+// Safe to call from any thread.
+namespace InterverseWire
+{
+    // Content type for HTTP bodies in the given format
+    INTERVERSECHAINPLUGIN_API const TCHAR* GetContentType(EInterverseWireFormat Format);
+
+    // Names used in the handshake's "formats" list and the node's reply
+    INTERVERSECHAINPLUGIN_API const TCHAR* GetFormatName(EInterverseWireFormat Format);
+    INTERVERSECHAINPLUGIN_API bool FindFormat(const FString& Name, EInterverseWireFormat& OutFormat);
+
+    // Condensed JSON text
+    INTERVERSECHAINPLUGIN_API FString ToJsonString(const TSharedRef<FJsonObject>& Object);
+
+    INTERVERSECHAINPLUGIN_API void ToMessagePack(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutBytes);
+    INTERVERSECHAINPLUGIN_API void ToMessagePack(const TSharedPtr<FJsonValue>& Value, TArray<uint8>& OutBytes);
+
+    // Null when the bytes are not one complete MessagePack map with string keys
+    INTERVERSECHAINPLUGIN_API TSharedPtr<FJsonObject> FromMessagePack(TArrayView<const uint8> Bytes);
+
+    // Building blocks for splicing already-encoded values into an envelope without re-encoding them
+    INTERVERSECHAINPLUGIN_API void AppendMapHeader(TArray<uint8>& Bytes, uint32 NumPairs);
+    INTERVERSECHAINPLUGIN_API void AppendArrayHeader(TArray<uint8>& Bytes, uint32 NumElements);
+    INTERVERSECHAINPLUGIN_API void AppendString(TArray<uint8>& Bytes, const FString& Value);
+
+    // Encodes and decodes Object Iterations times in each format
+    INTERVERSECHAINPLUGIN_API FInterverseWireComparison Compare(const TSharedRef<FJsonObject>& Object, int32 Iterations);
+}